@@ -0,0 +1,97 @@
+#include "AI.h"
+#include "Move.h"
+
+template <typename BoardType>
+TurnAction chooseHeuristicAction(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng) {
+    TurnAction action;
+    if (powerTurn) {
+        // Simple logic: If there's an opponent piece, consider conquering. Otherwise, always place.
+        char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+        int targetSquare = -1;
+        for (int i = 0; i < cellCount(board); ++i) {
+            if (cellSymbol(board, i) == opponentSymbol) {
+                targetSquare = i; // Find a potential target
+            }
+        }
+        if (targetSquare != -1 && rng.below(3) == 0) { // 1 in 3 chance to try conquering
+            action.conquer = true;
+            action.square = targetSquare;
+            return action;
+        }
+    }
+    action.square = findBestMove(board, playerSymbol, rng);
+    return action;
+}
+
+template <typename BoardType>
+TurnAction chooseSolvedAction(const BoardType& board, char playerSymbol, bool powerTurn, const PolicyTable& policy, Rng& rng) {
+    if (!isClassicBoard(board)) {
+        return chooseHeuristicAction(board, playerSymbol, powerTurn, rng);
+    }
+    char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+    uint8_t choice = policy.lookup(classicMarks(board, playerSymbol), classicMarks(board, opponentSymbol), powerTurn).action;
+    if (choice == POLICY_NO_ACTION) {
+        return chooseHeuristicAction(board, playerSymbol, false, rng);
+    }
+    TurnAction action;
+    action.conquer = isConquerAction(choice);
+    action.square = actionSquare(choice);
+    return action;
+}
+
+template <typename BoardType>
+int findBestMove(const BoardType& board, char playerSymbol, Rng& rng) {
+    char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+
+    // 1. Check for a winning move
+    int winningSquare = findCompletingSquare(board, playerSymbol);
+    if (winningSquare != -1) {
+        return winningSquare;
+    }
+
+    // 2. Check to block the opponent's winning move
+    int blockingSquare = findCompletingSquare(board, opponentSymbol);
+    if (blockingSquare != -1) {
+        return blockingSquare;
+    }
+
+    // 3. Take the center if available
+    int center = (board.size / 2) * board.size + board.size / 2;
+    if (isEmptySquare(board, center)) {
+        return center;
+    }
+
+    // 4. Take one of the corners (compile-time constants on a FixedBoard)
+    int last = board.size - 1;
+    const int corners[] = { 0, last, last * board.size, last * board.size + last };
+    int availableCorners[4];
+    int cornerCount = 0;
+    for (int i : corners) {
+        if (isEmptySquare(board, i)) {
+            availableCorners[cornerCount++] = i;
+        }
+    }
+    if (cornerCount > 0) {
+        return availableCorners[rng.below(cornerCount)];
+    }
+
+    // 5. Take any available square
+    MoveList availableMoves;
+    generatePlacements(board, availableMoves);
+    if (availableMoves.count > 0) {
+        return availableMoves[rng.below(availableMoves.count)];
+    }
+
+    return -1; // Should not happen in a normal game
+}
+
+// --- Instantiations ---
+#define INSTANTIATE_AI(BoardType) \
+    template TurnAction chooseHeuristicAction<BoardType>(const BoardType&, char, bool, Rng&); \
+    template TurnAction chooseSolvedAction<BoardType>(const BoardType&, char, bool, const PolicyTable&, Rng&); \
+    template int findBestMove<BoardType>(const BoardType&, char, Rng&);
+
+INSTANTIATE_AI(Board)
+INSTANTIATE_AI(Board3x3)
+INSTANTIATE_AI(Board4x4)
+INSTANTIATE_AI(Board15x15)
@@ -0,0 +1,29 @@
+#pragma once
+#include "Board.h"
+#include "FixedBoard.h"
+#include "Policy.h"
+#include "Rng.h"
+
+// --- AI Decisions ---
+// What a player does with their turn: place on an empty square, or (on a
+// power turn) try to conquer one of the opponent's squares.
+struct TurnAction {
+    bool conquer = false;
+    int square = -1; // 0-based index, -1 if there is nothing to do
+};
+
+// The decision functions below are templates over the board type. AI.cpp
+// instantiates them for Board and every FixedBoard specialization.
+
+// The original rule-of-thumb AI: findBestMove for placement, and a 1 in 3
+// chance of conquering the last opponent square it finds on a power turn.
+template <typename BoardType>
+TurnAction chooseHeuristicAction(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng);
+
+// Exact play straight out of the solved table (one lookup, no search).
+// Off the classic board it falls back to the heuristic.
+template <typename BoardType>
+TurnAction chooseSolvedAction(const BoardType& board, char playerSymbol, bool powerTurn, const PolicyTable& policy, Rng& rng);
+
+template <typename BoardType>
+int findBestMove(const BoardType& board, char playerSymbol, Rng& rng);
@@ -0,0 +1,6 @@
+#include "BenchSuite.h"
+
+// The benchmark suite as a program of its own (EchoGridBench).
+int main(int argc, char* argv[]) {
+    return benchSuiteCommand(argc, argv);
+}
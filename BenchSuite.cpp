@@ -0,0 +1,453 @@
+#include "BenchSuite.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Game.h"
+#include "Mcts.h"
+#include "Metrics.h"
+#include "Move.h"
+#include "Screen.h"
+#include "Simulation.h"
+
+namespace {
+
+const int SUITE_POSITIONS = 1024; // A power of two, so positions are picked with a mask
+const double DEFAULT_MIN_MS = 100.0;
+const int DEFAULT_REPETITIONS = 3;
+const double DEFAULT_THRESHOLD = 10.0; // Percent slower than the baseline that counts as a regression
+const uint64_t MAX_ITERATIONS = 1ull << 40;
+const uint64_t SEARCH_PLAYOUTS = 64; // Per mcts/... search
+
+// Everything a benchmark computes ends up here, so no work can be dropped
+// as unused.
+volatile uint64_t benchSink = 0;
+
+// Forces value to be materialized, as if something read it.
+template <typename T>
+void keep(const T& value) {
+    benchSink = benchSink + *reinterpret_cast<const volatile unsigned char*>(&value);
+}
+
+struct BenchCase {
+    std::string name;
+    // Performs the operation iterations times and returns a checksum of
+    // what it computed.
+    std::function<uint64_t(uint64_t iterations)> run;
+    // The operation must not touch the heap once its first run has warmed
+    // up whatever it reuses.
+    bool allocationFree = false;
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+    double allocsPerOp = 0.0; // On the calling thread, over the timed runs
+};
+
+// Positions as play reaches them: a random number of marks, alternating
+// sides, on random empty squares. At least one square is always left empty.
+template <typename BoardType>
+std::shared_ptr<std::vector<BoardType>> makePositions(const BoardType& empty, uint64_t seed) {
+    auto positions = std::make_shared<std::vector<BoardType>>();
+    Rng rng(seed);
+    int cells = cellCount(empty);
+    for (int p = 0; p < SUITE_POSITIONS; ++p) {
+        BoardType board = empty;
+        int marks = static_cast<int>(rng.below(static_cast<uint32_t>(cells)));
+        for (int m = 0; m < marks; ++m) {
+            int square;
+            do square = static_cast<int>(rng.below(static_cast<uint32_t>(cells)));
+            while (!isEmptySquare(board, square));
+            setCell(board, square, (m % 2 == 0) ? P1_SYMBOL : P2_SYMBOL);
+        }
+        positions->push_back(board);
+    }
+    return positions;
+}
+
+template <typename BoardType>
+void addBoardCases(std::vector<BenchCase>& cases, const std::string& label, const BoardType& empty,
+                   std::shared_ptr<Strategy> heuristic, uint64_t seed) {
+    auto positions = makePositions(empty, seed);
+    int cells = cellCount(empty);
+    std::vector<int> emptySquares; // One per position, for copyApply
+    for (const BoardType& board : *positions) {
+        int square = 0;
+        while (!isEmptySquare(board, square)) ++square;
+        emptySquares.push_back(square);
+    }
+
+    cases.push_back({ "checkWin/" + label, [positions, cells](uint64_t iterations) {
+        uint64_t checksum = 0;
+        int square = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const BoardType& board = (*positions)[i & (SUITE_POSITIONS - 1)];
+            checksum += checkWinAt(board, square, (i & 1) ? P2_SYMBOL : P1_SYMBOL) ? 1 : 0;
+            if (++square == cells) square = 0;
+        }
+        return checksum;
+    }, true });
+    cases.push_back({ "checkDraw/" + label, [positions](uint64_t iterations) {
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) checksum += checkDraw((*positions)[i & (SUITE_POSITIONS - 1)]) ? 1 : 0;
+        return checksum;
+    }, true });
+    cases.push_back({ "bestMove/" + label, [positions, seed](uint64_t iterations) {
+        Rng rng(seed);
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const BoardType& board = (*positions)[i & (SUITE_POSITIONS - 1)];
+            checksum += static_cast<uint64_t>(findBestMove(board, (i & 1) ? P2_SYMBOL : P1_SYMBOL, rng) + 1);
+        }
+        return checksum;
+    }, true });
+    cases.push_back({ "copyApply/" + label, [positions, emptySquares](uint64_t iterations) {
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            size_t p = i & (SUITE_POSITIONS - 1);
+            BoardType next = (*positions)[p];
+            setCell(next, emptySquares[p], P1_SYMBOL);
+            keep(next);
+            checksum += isEmptySquare(next, 0) ? 1 : 0;
+        }
+        return checksum;
+    }, true });
+    // The same change made in place and taken back, on a board that stays put.
+    cases.push_back({ "makeUnmake/" + label, [positions, emptySquares](uint64_t iterations) {
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            size_t p = i & (SUITE_POSITIONS - 1);
+            BoardType& board = (*positions)[p];
+            MoveUndo undo = makeMove(board, emptySquares[p], P1_SYMBOL);
+            keep(board);
+            checksum += isEmptySquare(board, 0) ? 1 : 0;
+            unmakeMove(board, undo);
+        }
+        return checksum;
+    }, true });
+    // One headless game per iteration on this thread; the checksum is the turns played.
+    cases.push_back({ "playGame/" + label, [heuristic, empty, seed](uint64_t iterations) {
+        Rng rng(seed);
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) checksum += playGame(*heuristic, *heuristic, empty, rng).turns;
+        return checksum;
+    }, true });
+    // One single-threaded search with a fixed playout budget per iteration.
+    cases.push_back({ "mcts/" + label, [positions, seed](uint64_t iterations) {
+        MctsOptions options;
+        options.thinkMs = 0;
+        options.maxPlayouts = SEARCH_PLAYOUTS;
+        Rng rng(seed);
+        uint64_t checksum = 0;
+        for (uint64_t i = 0; i < iterations; ++i) {
+            const BoardType& board = (*positions)[i & (SUITE_POSITIONS - 1)];
+            checksum += static_cast<uint64_t>(searchMcts(board, (i & 1) ? P2_SYMBOL : P1_SYMBOL, (i & 2) != 0, options, rng).square + 1);
+        }
+        return checksum;
+    }, true });
+}
+
+// Whole games on threads threads; the checksum is the turns played.
+void addGameCase(std::vector<BenchCase>& cases, const std::string& label, std::shared_ptr<Strategy> strategy,
+                 int size, int winLength, int threads, uint64_t seed) {
+    cases.push_back({ "games/" + label + "/threads:" + std::to_string(threads), [=](uint64_t iterations) {
+        SimulationOptions options;
+        options.games = iterations;
+        options.threads = threads;
+        options.seed = seed;
+        options.size = size;
+        options.winLength = winLength;
+        return runSimulation(*strategy, *strategy, options).turns;
+    } });
+}
+
+// One frame per iteration, each on a different position, so present() sends
+// a real diff rather than nothing.
+void addRenderCase(std::vector<BenchCase>& cases, const std::string& label, int size, int winLength, uint64_t seed) {
+    auto positions = makePositions(Board(size, winLength), seed);
+    cases.push_back({ "printBoard/" + label, [positions](uint64_t iterations) {
+        Screen screen(ScreenTarget::Discard);
+        for (uint64_t i = 0; i < iterations; ++i) {
+            screen.clear();
+            printBoard(screen, (*positions)[i & (SUITE_POSITIONS - 1)]);
+            screen.present();
+        }
+        return screen.stats().bytes;
+    } });
+}
+
+std::vector<BenchCase> makeSuite(int maxThreads, uint64_t seed) {
+    std::vector<BenchCase> cases;
+    PolicyTable policy; // Not needed by the heuristic
+    std::shared_ptr<Strategy> heuristic = makeStrategy("heuristic", policy);
+    addBoardCases(cases, "3x3/fixed", Board3x3(), heuristic, seed);
+    addBoardCases(cases, "3x3/generic", Board(3, 3), heuristic, seed);
+    addBoardCases(cases, "4x4/fixed", Board4x4(), heuristic, seed);
+    addBoardCases(cases, "4x4/generic", Board(4, 4), heuristic, seed);
+    addBoardCases(cases, "15x15/fixed", Board15x15(), heuristic, seed);
+    addBoardCases(cases, "15x15/generic", Board(15, 5), heuristic, seed);
+
+    for (int threads = 1; ; threads *= 2) {
+        int t = std::min(threads, maxThreads);
+        addGameCase(cases, "3x3", heuristic, 3, 3, t, seed);
+        addGameCase(cases, "4x4", heuristic, 4, 4, t, seed);
+        addGameCase(cases, "15x15", heuristic, 15, 5, t, seed);
+        if (t == maxThreads) break;
+    }
+
+    addRenderCase(cases, "3x3", 3, 3, seed);
+    addRenderCase(cases, "9x9", 9, 5, seed);
+    addRenderCase(cases, "15x15", 15, 5, seed);
+    addRenderCase(cases, "19x19", 19, 5, seed);
+    return cases;
+}
+
+double timeRun(const BenchCase& bench, uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    benchSink = benchSink + bench.run(iterations);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Grows the iteration count until one run takes a tenth of the budget, then
+// sizes the timed runs to fill it and keeps the median.
+BenchResult runCase(const BenchCase& bench, double minSeconds, int repetitions) {
+    uint64_t iterations = 1;
+    double seconds = timeRun(bench, iterations);
+    while (seconds < minSeconds / 10.0 && iterations < MAX_ITERATIONS) {
+        double grow = (seconds > 0.0) ? (minSeconds / 10.0) / seconds * 1.4 : 10.0;
+        iterations = static_cast<uint64_t>(iterations * std::min(10.0, std::max(2.0, grow)));
+        seconds = timeRun(bench, iterations);
+    }
+    iterations = std::max<uint64_t>(1, static_cast<uint64_t>(iterations * (minSeconds / seconds)));
+
+    std::vector<double> perOp;
+    perOp.reserve(repetitions);
+    uint64_t allocationsBefore = threadAllocations();
+    for (int r = 0; r < repetitions; ++r) perOp.push_back(timeRun(bench, iterations) * 1e9 / iterations);
+    uint64_t allocations = threadAllocations() - allocationsBefore;
+    std::sort(perOp.begin(), perOp.end());
+    BenchResult result;
+    result.name = bench.name;
+    result.iterations = iterations;
+    result.nsPerOp = perOp[perOp.size() / 2];
+    result.allocsPerOp = static_cast<double>(allocations) / (static_cast<double>(iterations) * repetitions);
+    return result;
+}
+
+std::string formatTime(double ns) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(ns < 10.0 ? 2 : 1);
+    if (ns < 1e3) out << ns << " ns";
+    else if (ns < 1e6) out << ns / 1e3 << " us";
+    else out << ns / 1e6 << " ms";
+    return out.str();
+}
+
+std::string formatRate(double perSecond) {
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(1);
+    if (perSecond >= 1e6) out << perSecond / 1e6 << " M/s";
+    else if (perSecond >= 1e3) out << perSecond / 1e3 << " k/s";
+    else out << perSecond << " /s";
+    return out.str();
+}
+
+// --- Results File ---
+bool writeResults(const std::string& path, const std::vector<BenchResult>& results, int hardwareThreads,
+                  double minMs, int repetitions, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "could not create '" + path + "'";
+        return false;
+    }
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+    std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"num_cpus\": %d,\n"
+                       "    \"min_time_ms\": %g,\n    \"repetitions\": %d,\n    \"metrics\": %s\n  },\n  \"benchmarks\": [\n",
+                 date, hardwareThreads, minMs, repetitions, ECHOGRID_METRICS ? "true" : "false");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchResult& r = results[i];
+        std::fprintf(file, "    { \"name\": \"%s\", \"iterations\": %llu, \"real_time\": %.4f, \"time_unit\": \"ns\", \"items_per_second\": %.1f, \"allocs_per_iteration\": %.4f }%s\n",
+                     r.name.c_str(), static_cast<unsigned long long>(r.iterations), r.nsPerOp, 1e9 / r.nsPerOp, r.allocsPerOp,
+                     (i + 1 < results.size()) ? "," : "");
+    }
+    std::fprintf(file, "  ]\n}\n");
+    if (std::fclose(file) != 0) {
+        error = "could not write '" + path + "'";
+        return false;
+    }
+    return true;
+}
+
+// Reads the name and real_time of every benchmark in a results file. Only
+// as much JSON as writeResults (or Google Benchmark, in nanoseconds) writes.
+bool readResults(const std::string& path, std::vector<BenchResult>& results, std::string& error) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) {
+        error = "could not read '" + path + "'";
+        return false;
+    }
+    std::string text;
+    char buffer[4096];
+    size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, got);
+    std::fclose(file);
+
+    const std::string nameKey = "\"name\"";
+    const std::string timeKey = "\"real_time\"";
+    size_t at = text.find("\"benchmarks\"");
+    while (at != std::string::npos && (at = text.find(nameKey, at)) != std::string::npos) {
+        size_t open = text.find('"', text.find(':', at + nameKey.size()));
+        size_t close = text.find('"', open + 1);
+        size_t time = text.find(timeKey, close);
+        size_t nextName = text.find(nameKey, close);
+        if (open == std::string::npos || close == std::string::npos || time == std::string::npos || time > nextName) {
+            error = "'" + path + "' is not a benchmark results file";
+            return false;
+        }
+        BenchResult result;
+        result.name = text.substr(open + 1, close - open - 1);
+        result.nsPerOp = std::strtod(text.c_str() + text.find(':', time) + 1, nullptr);
+        results.push_back(result);
+        at = close;
+    }
+    if (results.empty()) {
+        error = "'" + path + "' holds no benchmarks";
+        return false;
+    }
+    return true;
+}
+
+// Prints every benchmark next to its baseline; returns the regressions.
+int compareResults(const std::vector<BenchResult>& results, const std::vector<BenchResult>& baseline, double threshold) {
+    int regressions = 0;
+    std::cout << "\nAgainst the baseline (regression past +" << threshold << "%)\n"
+              << "  " << std::left << std::setw(34) << "benchmark" << std::right
+              << std::setw(12) << "baseline" << std::setw(12) << "now" << std::setw(11) << "change" << "\n";
+    for (const BenchResult& now : results) {
+        auto before = std::find_if(baseline.begin(), baseline.end(), [&](const BenchResult& b) { return b.name == now.name; });
+        std::cout << "  " << std::left << std::setw(34) << now.name << std::right;
+        if (before == baseline.end() || before->nsPerOp <= 0.0) {
+            std::cout << std::setw(12) << "-" << std::setw(12) << formatTime(now.nsPerOp) << "       new\n";
+            continue;
+        }
+        double change = (now.nsPerOp - before->nsPerOp) / before->nsPerOp * 100.0;
+        std::ostringstream percent;
+        percent << std::showpos << std::fixed << std::setprecision(1) << change << "%";
+        std::cout << std::setw(12) << formatTime(before->nsPerOp) << std::setw(12) << formatTime(now.nsPerOp)
+                  << std::setw(11) << percent.str();
+        if (change > threshold) {
+            std::cout << "   REGRESSION";
+            ++regressions;
+        }
+        else if (change < -threshold) {
+            std::cout << "   faster";
+        }
+        std::cout << "\n";
+    }
+    return regressions;
+}
+
+} // namespace
+
+int benchSuiteCommand(int argc, char* argv[]) {
+    std::string filter;
+    bool listOnly = false;
+    double minMs = DEFAULT_MIN_MS;
+    int repetitions = DEFAULT_REPETITIONS;
+    int hardwareThreads = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    int maxThreads = hardwareThreads;
+    uint64_t seed = 1;
+    std::string outPath;
+    std::string baselinePath;
+    double threshold = DEFAULT_THRESHOLD;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--filter" && hasValue) filter = argv[++i];
+        else if (arg == "--list") listOnly = true;
+        else if (arg == "--min-ms" && hasValue) minMs = std::atof(argv[++i]);
+        else if (arg == "--repetitions" && hasValue) repetitions = std::atoi(argv[++i]);
+        else if (arg == "--threads" && hasValue) maxThreads = std::atoi(argv[++i]);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--out" && hasValue) outPath = argv[++i];
+        else if (arg == "--baseline" && hasValue) baselinePath = argv[++i];
+        else if (arg == "--threshold" && hasValue) threshold = std::atof(argv[++i]);
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n"
+                      << "Usage: EchoGridBench [--filter TEXT] [--list] [--min-ms MS] [--repetitions R] [--threads N]\n"
+                      << "       [--seed S] [--out FILE] [--baseline FILE] [--threshold PCT]\n";
+            return 1;
+        }
+    }
+    if (maxThreads < 1) maxThreads = 1;
+    if (repetitions < 1) repetitions = 1;
+    if (minMs <= 0.0) minMs = DEFAULT_MIN_MS;
+
+    std::vector<BenchResult> baseline;
+    std::string error;
+    if (!baselinePath.empty() && !readResults(baselinePath, baseline, error)) {
+        std::cout << "Could not load the baseline: " << error << ".\n";
+        return 1;
+    }
+
+    std::vector<BenchCase> suite = makeSuite(maxThreads, seed);
+    std::vector<BenchResult> results;
+    int allocating = 0; // Allocation-free benchmarks that allocated
+    if (!listOnly) {
+        std::cout << "Median of " << repetitions << " runs of " << minMs << " ms each, " << hardwareThreads << " hardware threads\n"
+                  << "  " << std::left << std::setw(34) << "benchmark" << std::right
+                  << std::setw(14) << "iterations" << std::setw(12) << "time/op" << std::setw(12) << "rate" << std::setw(12) << "allocs/op" << "\n";
+    }
+    for (const BenchCase& bench : suite) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) continue;
+        if (listOnly) {
+            std::cout << bench.name << "\n";
+            continue;
+        }
+        BenchResult result = runCase(bench, minMs / 1000.0, repetitions);
+        std::ostringstream allocs;
+        allocs << std::fixed << std::setprecision(result.allocsPerOp < 10.0 ? 2 : 0) << result.allocsPerOp;
+        std::cout << "  " << std::left << std::setw(34) << result.name << std::right << std::setw(14) << result.iterations
+                  << std::setw(12) << formatTime(result.nsPerOp) << std::setw(12) << formatRate(1e9 / result.nsPerOp)
+                  << std::setw(12) << allocs.str();
+        if (bench.allocationFree && result.allocsPerOp > 0.0) {
+            std::cout << "   ALLOCATES";
+            ++allocating;
+        }
+        std::cout << std::endl;
+        results.push_back(result);
+    }
+    if (listOnly) return 0;
+
+    if (!outPath.empty()) {
+        if (!writeResults(outPath, results, hardwareThreads, minMs, repetitions, error)) {
+            std::cout << "Could not save the results: " << error << ".\n";
+            return 1;
+        }
+        std::cout << "Wrote " << results.size() << " results to '" << outPath << "'.\n";
+    }
+    if (!baselinePath.empty()) {
+        int regressions = compareResults(results, baseline, threshold);
+        std::cout << regressions << " regression" << (regressions == 1 ? "" : "s") << ".\n";
+        if (regressions > 0) return 1;
+    }
+    if (allocating > 0) {
+        std::cout << allocating << " allocation-free benchmark" << (allocating == 1 ? "" : "s") << " allocated.\n";
+        return 1;
+    }
+    return 0;
+}
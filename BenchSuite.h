@@ -0,0 +1,33 @@
+#pragma once
+
+// --- Benchmark Suite ---
+// Named benchmarks for the operations the game and the simulator spend
+// their time in, built as their own program (EchoGridBench):
+//
+//   checkWin/..., checkDraw/..., bestMove/..., copyApply/..., makeUnmake/...
+//       one call on a varied set of positions, for each FixedBoard
+//       specialization and the runtime-sized Board
+//   playGame/..., mcts/...
+//       a whole heuristic game, and a 64-playout search, on one thread
+//   games/<board>/threads:T
+//       whole heuristic-vs-heuristic headless games on 1..N threads
+//   printBoard/<board>
+//       drawing the grid into a frame and presenting the diff
+//
+// Each benchmark runs with a growing iteration count until one run fills a
+// tenth of the time budget, then is timed over the full budget several
+// times; the median time per operation is what gets reported. Results can
+// be written as JSON (the same "benchmarks" array of name, iterations and
+// real_time that Google Benchmark writes) and compared against an earlier
+// file, where anything slower by more than the threshold is a regression.
+//
+// Heap allocations on the benchmark's thread are counted over the timed
+// runs too. The per-position cases, playGame and mcts must make none: apply
+// and undo work in place, move lists live on the stack and searches reuse
+// their thread's node pool and table. One that allocates fails the suite.
+
+// Entry point for "EchoGridBench [--filter TEXT] [--list] [--min-ms MS]
+// [--repetitions R] [--threads N] [--seed S] [--out FILE] [--baseline FILE]
+// [--threshold PCT]". Exits with 1 if a benchmark regressed or an
+// allocation-free one allocated.
+int benchSuiteCommand(int argc, char* argv[]);
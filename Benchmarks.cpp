@@ -0,0 +1,357 @@
+#include "Benchmarks.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "Screen.h"
+#include "Simulation.h"
+#include "WinBatch.h"
+
+namespace {
+
+const int BENCH_POSITIONS = 4096;
+const int BENCH_PASSES = 64;
+
+template <typename Work>
+double timeSeconds(Work&& work) {
+    auto start = std::chrono::steady_clock::now();
+    work();
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+// Random (not necessarily reachable) positions, each stored both ways.
+template <typename BoardType>
+void makePositions(int size, int winLength, uint64_t seed, std::vector<BoardType>& fixed, std::vector<Board>& generic) {
+    Rng rng(seed);
+    for (int p = 0; p < BENCH_POSITIONS; ++p) {
+        BoardType fixedBoard;
+        Board genericBoard(size, winLength);
+        for (int i = 0; i < size * size; ++i) {
+            uint32_t owner = rng.below(3);
+            if (owner == 0) continue;
+            char symbol = (owner == 1) ? P1_SYMBOL : P2_SYMBOL;
+            setCell(fixedBoard, i, symbol);
+            setCell(genericBoard, i, symbol);
+        }
+        fixed.push_back(fixedBoard);
+        generic.push_back(genericBoard);
+    }
+}
+
+// Probes every square of every position for both sides. Each pass starts
+// on a different square and folds the answers in order, so the compiler
+// cannot hoist repeated passes out of the timing loop.
+template <typename BoardType>
+uint64_t winCheckPass(const std::vector<BoardType>& positions, int pass) {
+    uint64_t checksum = 0;
+    for (const BoardType& board : positions) {
+        int cells = cellCount(board);
+        int square = pass % cells;
+        for (int i = 0; i < cells; ++i) {
+            checksum = checksum * 3 + (checkWinAt(board, square, P1_SYMBOL) ? 1 : 0) + (checkWinAt(board, square, P2_SYMBOL) ? 1 : 0);
+            if (++square == cells) square = 0;
+        }
+    }
+    return checksum;
+}
+
+template <typename BoardType>
+uint64_t bestMovePass(const std::vector<BoardType>& positions, uint64_t seed) {
+    Rng rng(seed);
+    uint64_t total = 0;
+    for (const BoardType& board : positions) {
+        total += static_cast<uint64_t>(findBestMove(board, P1_SYMBOL, rng) + 1);
+    }
+    return total;
+}
+
+void printRow(const char* label, double genericSeconds, double fixedSeconds, double operations, bool identical) {
+    std::cout << "  " << std::left << std::setw(12) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << genericSeconds * 1e9 / operations << " ns"
+              << std::setw(9) << fixedSeconds * 1e9 / operations << " ns"
+              << std::setw(8) << std::setprecision(2) << genericSeconds / fixedSeconds << "x"
+              << (identical ? "" : "   MISMATCH") << "\n";
+}
+
+template <typename BoardType>
+bool benchmarkKernels(int size, int winLength, uint64_t seed) {
+    std::vector<BoardType> fixed;
+    std::vector<Board> generic;
+    makePositions(size, winLength, seed, fixed, generic);
+
+    uint64_t fixedWins = 0;
+    uint64_t genericWins = 0;
+    double genericSeconds = timeSeconds([&]() { for (int r = 0; r < BENCH_PASSES; ++r) genericWins += winCheckPass(generic, r); });
+    double fixedSeconds = timeSeconds([&]() { for (int r = 0; r < BENCH_PASSES; ++r) fixedWins += winCheckPass(fixed, r); });
+    double probes = 2.0 * BENCH_PASSES * BENCH_POSITIONS * size * size;
+    printRow("win check", genericSeconds, fixedSeconds, probes, fixedWins == genericWins);
+    bool identical = fixedWins == genericWins;
+
+    uint64_t fixedMoves = 0;
+    uint64_t genericMoves = 0;
+    genericSeconds = timeSeconds([&]() { for (int r = 0; r < BENCH_PASSES; ++r) genericMoves += bestMovePass(generic, seed + r); });
+    fixedSeconds = timeSeconds([&]() { for (int r = 0; r < BENCH_PASSES; ++r) fixedMoves += bestMovePass(fixed, seed + r); });
+    printRow("best move", genericSeconds, fixedSeconds, static_cast<double>(BENCH_PASSES) * BENCH_POSITIONS, fixedMoves == genericMoves);
+    return identical && fixedMoves == genericMoves;
+}
+
+bool sameStats(const SimulationStats& a, const SimulationStats& b) {
+    return a.games == b.games && a.turns == b.turns && a.firstMoverWins == b.firstMoverWins &&
+           a.wins[0] == b.wins[0] && a.wins[1] == b.wins[1] && a.wins[2] == b.wins[2];
+}
+
+// Whole seeded games on one thread; both paths must play the same games.
+bool benchmarkGames(const Strategy& strategy, int size, int winLength, uint64_t games, uint64_t seed) {
+    SimulationOptions options;
+    options.games = games;
+    options.seed = seed;
+    options.size = size;
+    options.winLength = winLength;
+    SimulationStats fixedStats;
+    SimulationStats genericStats;
+    options.generic = true;
+    double genericSeconds = timeSeconds([&]() { genericStats = runSimulation(strategy, strategy, options); });
+    options.generic = false;
+    double fixedSeconds = timeSeconds([&]() { fixedStats = runSimulation(strategy, strategy, options); });
+    printRow("full game", genericSeconds, fixedSeconds, static_cast<double>(games), sameStats(fixedStats, genericStats));
+    return sameStats(fixedStats, genericStats);
+}
+
+// Roughly the game screen for a large board: the grid, then a status line.
+void drawFrame(Screen& screen, const Board& board, int turn) {
+    screen.clear();
+    screen.setColor(COLOR_WHITE);
+    int n = board.size;
+    for (int row = 0; row < n; ++row) {
+        for (int col = 0; col < n; ++col) {
+            int i = row * n + col;
+            char cell = cellSymbol(board, i);
+            std::string label = (cell != '\0') ? std::string(1, cell) : std::to_string(i + 1);
+            screen << std::string(5 - label.size(), ' ');
+            screen.setColor(cell == P1_SYMBOL ? COLOR_BLUE : cell == P2_SYMBOL ? COLOR_RED : COLOR_GREY);
+            screen << label;
+            screen.setColor(COLOR_WHITE);
+            screen << '|';
+        }
+        screen << '\n' << std::string(n * 6, '_') << '\n';
+    }
+    screen << "Turn " << turn << ": " << (turn % 2 == 0 ? "Blue" : "Red") << " Side to move\n";
+}
+
+// Fills a 19x19 board one random square per frame, sending each frame either
+// whole to a fresh terminal or as a diff against the previous one.
+void benchmarkRendering(uint64_t seed) {
+    const int size = MAX_BOARD_SIZE;
+    std::vector<int> order(size * size);
+    for (int i = 0; i < size * size; ++i) order[i] = i;
+    Rng rng(seed);
+    for (int i = size * size - 1; i > 0; --i) std::swap(order[i], order[rng.below(i + 1)]);
+
+    uint64_t fullBytes = 0;
+    Board fullBoard(size, size);
+    double fullSeconds = timeSeconds([&]() {
+        for (int turn = 0; turn < size * size; ++turn) {
+            setCell(fullBoard, order[turn], turn % 2 == 0 ? P1_SYMBOL : P2_SYMBOL);
+            Screen fresh(ScreenTarget::Discard);
+            drawFrame(fresh, fullBoard, turn);
+            fresh.present();
+            fullBytes += fresh.stats().bytes;
+        }
+    });
+
+    Screen screen(ScreenTarget::Discard);
+    Board diffBoard(size, size);
+    double diffSeconds = timeSeconds([&]() {
+        for (int turn = 0; turn < size * size; ++turn) {
+            setCell(diffBoard, order[turn], turn % 2 == 0 ? P1_SYMBOL : P2_SYMBOL);
+            drawFrame(screen, diffBoard, turn);
+            screen.present();
+        }
+    });
+
+    double frames = size * size;
+    std::cout << "Per 19x19 frame      bytes       time\n" << std::fixed << std::setprecision(1);
+    std::cout << "  full redraw   " << std::setw(9) << fullBytes / frames << std::setw(9) << fullSeconds * 1e6 / frames << " us\n";
+    std::cout << "  diff redraw   " << std::setw(9) << screen.stats().bytes / frames << std::setw(9) << diffSeconds * 1e6 / frames << " us\n";
+}
+
+// Whole-board status the scalar way: a last-move check from every mark.
+uint8_t scalarStatus(const Board4x4& board) {
+    bool blue = false;
+    bool red = false;
+    for (int i = 0; i < cellCount(board); ++i) {
+        char owner = cellSymbol(board, i);
+        if (owner == P1_SYMBOL && !blue) blue = checkWinAt(board, i, P1_SYMBOL);
+        else if (owner == P2_SYMBOL && !red) red = checkWinAt(board, i, P2_SYMBOL);
+    }
+    return static_cast<uint8_t>((blue ? BATCH_BLUE_LINE : 0) | (red ? BATCH_RED_LINE : 0) | (checkDraw(board) ? BATCH_FULL : 0));
+}
+
+// A uniformly random empty square of a board with occupied set.
+int randomEmptySquare(uint64_t occupied, int cells, Rng& rng) {
+    int skip = static_cast<int>(rng.below(static_cast<uint32_t>(cells - countBits(occupied))));
+    for (int square = 0; square < cells; ++square) {
+        if ((occupied >> square) & 1) continue;
+        if (skip-- == 0) return square;
+    }
+    return -1;
+}
+
+void printRate(const char* label, double seconds, double items, double baselineSeconds, bool identical) {
+    std::cout << "  " << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(9) << items / seconds / 1e6 << " M/s"
+              << std::setw(8) << std::setprecision(2) << baselineSeconds / seconds << "x"
+              << (identical ? "" : "   MISMATCH") << "\n";
+}
+
+// The batched kernel against per-board scalar checks on 4x4 positions, then
+// random playouts run one at a time or as a compacting batch. Every game
+// draws from its own Rng, so both ways play identical games.
+bool benchmarkBatch(uint64_t games, uint64_t seed) {
+    const int size = 4;
+    const int positionCount = BENCH_POSITIONS * 4;
+    GameBatch batch(size, size);
+    std::vector<Board4x4> boards(positionCount);
+    Rng rng(seed);
+    for (int p = 0; p < positionCount; ++p) {
+        for (int i = 0; i < size * size; ++i) {
+            uint32_t owner = rng.below(3);
+            if (owner != 0) setCell(boards[p], i, owner == 1 ? P1_SYMBOL : P2_SYMBOL);
+        }
+        batch.add(static_cast<uint32_t>(p), boards[p].p1, boards[p].p2);
+    }
+
+    std::vector<uint8_t> expected(positionCount);
+    double scalarSeconds = timeSeconds([&]() {
+        for (int r = 0; r < BENCH_PASSES; ++r) {
+            for (int p = 0; p < positionCount; ++p) expected[p] ^= scalarStatus(boards[p]);
+        }
+    });
+    for (int p = 0; p < positionCount; ++p) expected[p] = scalarStatus(boards[p]);
+    double evaluations = static_cast<double>(BENCH_PASSES) * positionCount;
+    bool identical = true;
+
+    std::cout << "Batch win/draw, 4x4      boards   speedup\n";
+    printRate("checkWinAt per board", scalarSeconds, evaluations, scalarSeconds, true);
+    for (BatchKernel kernel : { BatchKernel::Scalar, BatchKernel::Sse41, BatchKernel::Avx2 }) {
+        if (!batchKernelSupported(kernel)) continue;
+        std::vector<uint8_t> status;
+        uint64_t checksum = 0;
+        double seconds = timeSeconds([&]() {
+            for (int r = 0; r < BENCH_PASSES; ++r) {
+                batch.evaluate(status, kernel);
+                checksum += status[r % positionCount];
+            }
+        });
+        bool same = (status == expected) && checksum != ~0ull;
+        identical &= same;
+        printRate((std::string("batch, ") + batchKernelName(kernel)).c_str(), seconds, evaluations, scalarSeconds, same);
+    }
+
+    // Random playouts to the end
+    const size_t window = BENCH_POSITIONS;
+    uint64_t singleWins[2] = {};
+    double singleSeconds = timeSeconds([&]() {
+        for (uint64_t g = 0; g < games; ++g) {
+            Rng gameRng(seed, g);
+            Board4x4 board;
+            for (int turn = 0; ; ++turn) {
+                char symbol = (turn % 2 == 0) ? P1_SYMBOL : P2_SYMBOL;
+                int square = randomEmptySquare(uint64_t(board.p1) | board.p2, size * size, gameRng);
+                setCell(board, square, symbol);
+                if (checkWinAt(board, square, symbol)) {
+                    ++singleWins[turn % 2];
+                    break;
+                }
+                if (checkDraw(board)) break;
+            }
+        }
+    });
+
+    uint64_t batchWins[2] = {};
+    double batchSeconds = timeSeconds([&]() {
+        // A game's batch id is its slot in rngs, reused once it finishes.
+        GameBatch playing(size, size);
+        std::vector<Rng> rngs;
+        std::vector<uint32_t> freeIds;
+        std::vector<uint8_t> status;
+        std::vector<std::pair<uint32_t, uint8_t>> finished;
+        uint64_t next = 0;
+        while (next < games || !playing.empty()) {
+            while (playing.count() < window && next < games) {
+                uint32_t id = static_cast<uint32_t>(rngs.size());
+                if (!freeIds.empty()) {
+                    id = freeIds.back();
+                    freeIds.pop_back();
+                    rngs[id] = Rng(seed, next++);
+                }
+                else {
+                    rngs.emplace_back(seed, next++);
+                }
+                playing.add(id);
+            }
+            for (size_t slot = 0; slot < playing.count(); ++slot) {
+                uint64_t occupied = playing.blue(slot) | playing.red(slot);
+                char symbol = (countBits(occupied) % 2 == 0) ? P1_SYMBOL : P2_SYMBOL;
+                playing.place(slot, symbol, randomEmptySquare(occupied, size * size, rngs[playing.id(slot)]));
+            }
+            playing.evaluate(status);
+            finished.clear();
+            playing.compact(status, finished);
+            for (const auto& done : finished) {
+                if (done.second & BATCH_BLUE_LINE) ++batchWins[0];
+                if (done.second & BATCH_RED_LINE) ++batchWins[1];
+                freeIds.push_back(done.first);
+            }
+        }
+    });
+    bool sameGames = singleWins[0] == batchWins[0] && singleWins[1] == batchWins[1];
+    identical &= sameGames;
+    std::cout << "Random playouts, 4x4      games   speedup\n";
+    printRate("one at a time", singleSeconds, static_cast<double>(games), singleSeconds, true);
+    printRate((std::string("batched, ") + batchKernelName(bestBatchKernel())).c_str(), batchSeconds, static_cast<double>(games), singleSeconds, sameGames);
+    return identical;
+}
+
+} // namespace
+
+int benchmarkCommand(int argc, char* argv[]) {
+    uint64_t games = 200000;
+    uint64_t seed = 1;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--bench") continue;
+        else if (arg == "--games" && hasValue) games = std::strtoull(argv[++i], nullptr, 10);
+        else if (arg == "--seed" && hasValue) seed = std::strtoull(argv[++i], nullptr, 10);
+        else {
+            std::cout << "Unknown option '" << arg << "'.\nUsage: EchoGrid --bench [--games N] [--seed S]\n";
+            return 1;
+        }
+    }
+
+    PolicyTable policy; // Not needed by the heuristic
+    std::unique_ptr<Strategy> heuristic = makeStrategy("heuristic", policy);
+    bool identical = true;
+
+    std::cout << "Per operation      generic      fixed   speedup\n";
+    std::cout << "3x3, 3 in a row\n";
+    identical &= benchmarkKernels<Board3x3>(3, 3, seed);
+    identical &= benchmarkGames(*heuristic, 3, 3, games, seed);
+    std::cout << "4x4, 4 in a row\n";
+    identical &= benchmarkKernels<Board4x4>(4, 4, seed);
+    identical &= benchmarkGames(*heuristic, 4, 4, games, seed);
+
+    identical &= benchmarkBatch(games, seed);
+    benchmarkRendering(seed);
+
+    if (!identical) {
+        std::cout << "Specialized and generic boards disagree.\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+// --- Benchmarks ---
+// Times the FixedBoard specializations against the runtime-sized Board on
+// the same positions and the same seeded games, and checks that both give
+// identical answers. Also times the batched SIMD win/draw kernel against
+// per-board checks, and measures what the diff-based Screen sends per frame
+// on the largest board, against repainting every frame in full.
+
+// Entry point for "EchoGrid --bench [--games N] [--seed S]".
+int benchmarkCommand(int argc, char* argv[]);
@@ -0,0 +1,166 @@
+#pragma once
+#include <cstdint>
+#if defined(_MSC_VER)
+#include <intrin.h> // For __popcnt and _BitScanForward
+#endif
+
+// --- Player Symbol Constants ---
+const char P1_SYMBOL = 'X'; // Human Player
+const char P2_SYMBOL = 'O'; // Human Player 2 or AI
+
+// --- Board Geometry ---
+// The board is N x N with K in a row to win, both chosen at runtime. The
+// classic game is 3 x 3 with three in a row.
+const int CLASSIC_SIZE = 3;
+const int MIN_BOARD_SIZE = 3;
+const int MAX_BOARD_SIZE = 19;
+const int MAX_CELLS = MAX_BOARD_SIZE * MAX_BOARD_SIZE;
+const int CELL_WORDS = (MAX_CELLS + 63) / 64;
+
+inline int countBits(uint32_t mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(mask));
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+inline int countBits(uint64_t mask) {
+    return countBits(static_cast<uint32_t>(mask)) + countBits(static_cast<uint32_t>(mask >> 32));
+}
+
+// Index of the lowest set bit; mask must not be zero.
+inline int lowestBit(uint64_t mask) {
+#if defined(_MSC_VER)
+    unsigned long index; // Two 32-bit scans so Win32 builds work too
+    if (_BitScanForward(&index, static_cast<unsigned long>(mask))) return static_cast<int>(index);
+    _BitScanForward(&index, static_cast<unsigned long>(mask >> 32));
+    return static_cast<int>(index) + 32;
+#else
+    return __builtin_ctzll(mask);
+#endif
+}
+
+// One bit per square, big enough for the largest board.
+struct CellSet {
+    uint64_t words[CELL_WORDS] = {};
+
+    bool test(int index) const { return ((words[index >> 6] >> (index & 63)) & 1) != 0; }
+    void set(int index) { words[index >> 6] |= 1ull << (index & 63); }
+    void reset(int index) { words[index >> 6] &= ~(1ull << (index & 63)); }
+};
+
+// --- Game State ---
+// One occupancy bit set per side plus the side to move. filled is kept up to
+// date by setCell so the draw check never has to scan the board.
+struct Board {
+    int size = CLASSIC_SIZE;       // Squares per side (N)
+    int winLength = CLASSIC_SIZE;  // Marks in a row needed to win (K)
+    int filled = 0;                // Occupied squares
+    CellSet p1;                    // Squares held by Blue Side (X)
+    CellSet p2;                    // Squares held by Red Side (O)
+    uint8_t toMove = 1;            // 1 = Blue Side, 2 = Red Side
+
+    Board() = default;
+    Board(int size, int winLength) : size(size), winLength(winLength) {}
+};
+
+inline bool isValidGeometry(int size, int winLength) {
+    return size >= MIN_BOARD_SIZE && size <= MAX_BOARD_SIZE && winLength >= 3 && winLength <= size;
+}
+
+inline int cellCount(const Board& board) {
+    return board.size * board.size;
+}
+
+inline bool isClassicBoard(const Board& board) {
+    return board.size == CLASSIC_SIZE && board.winLength == CLASSIC_SIZE;
+}
+
+inline const CellSet& marksOf(const Board& board, char playerSymbol) {
+    return playerSymbol == P1_SYMBOL ? board.p1 : board.p2;
+}
+
+// The low 9 bits of a side's marks on the classic board, as the solver uses them.
+inline uint16_t classicMarks(const Board& board, char playerSymbol) {
+    return static_cast<uint16_t>(marksOf(board, playerSymbol).words[0] & 0x1FF);
+}
+
+inline bool isEmptySquare(const Board& board, int index) {
+    return !board.p1.test(index) && !board.p2.test(index);
+}
+
+// The owner's symbol, or '\0' if the square is empty.
+inline char cellSymbol(const Board& board, int index) {
+    if (board.p1.test(index)) return P1_SYMBOL;
+    if (board.p2.test(index)) return P2_SYMBOL;
+    return '\0';
+}
+
+// Places (or conquers) a square for playerSymbol, clearing any previous owner.
+inline void setCell(Board& board, int index, char playerSymbol) {
+    if (isEmptySquare(board, index)) ++board.filled;
+    if (playerSymbol == P1_SYMBOL) {
+        board.p1.set(index);
+        board.p2.reset(index);
+    }
+    else {
+        board.p2.set(index);
+        board.p1.reset(index);
+    }
+}
+
+// Empties a square, as taking a turn back does.
+inline void clearCell(Board& board, int index) {
+    if (!isEmptySquare(board, index)) --board.filled;
+    board.p1.reset(index);
+    board.p2.reset(index);
+}
+
+// True if playerSymbol holding square index gives K in a row through it.
+// Only the four directions through that square are walked, so this costs
+// O(K) whatever the board size. The square itself is assumed to be held,
+// which makes it double as a "would this placement win?" probe.
+inline bool makesLine(const Board& board, int index, char playerSymbol) {
+    static const int DIRECTIONS[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+    const CellSet& marks = marksOf(board, playerSymbol);
+    int n = board.size;
+    int row = index / n;
+    int col = index % n;
+    for (const auto& d : DIRECTIONS) {
+        int run = 1;
+        for (int sign = -1; sign <= 1; sign += 2) {
+            int r = row + sign * d[0];
+            int c = col + sign * d[1];
+            while (run < board.winLength && r >= 0 && r < n && c >= 0 && c < n && marks.test(r * n + c)) {
+                ++run;
+                r += sign * d[0];
+                c += sign * d[1];
+            }
+        }
+        if (run >= board.winLength) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Win check after playerSymbol claims a square; only lines through the last
+// changed square can have been completed.
+inline bool checkWinAt(const Board& board, int index, char playerSymbol) {
+    return index >= 0 && makesLine(board, index, playerSymbol);
+}
+
+// Lowest empty square that would complete a line for playerSymbol, or -1.
+inline int findCompletingSquare(const Board& board, char playerSymbol) {
+    for (int i = 0; i < cellCount(board); ++i) {
+        if (isEmptySquare(board, i) && makesLine(board, i, playerSymbol)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+inline bool checkDraw(const Board& board) {
+    return board.filled == cellCount(board);
+}
@@ -0,0 +1,357 @@
+#pragma once
+#include <cstdint>
+#include <type_traits>
+#include <utility> // For integer_sequence
+#include "Board.h"
+
+// --- Compile-Time Board Specializations ---
+// FixedBoard<N, K> is the N x N, K-in-a-row board with its geometry baked in.
+// Occupancy lives in the narrowest mask that holds N * N bits, and the
+// winning lines, neighbour steps and the eight symmetries are generated by
+// constexpr code instead of being written out by hand. Boards that fit in 64
+// bits test wins with a handful of mask compares; wider ones walk the
+// precomputed neighbour table. The runtime-sized Board covers every other
+// geometry, and withBoard() picks between them once per game.
+
+template <int Words>
+struct WideMask {
+    uint64_t words[Words] = {};
+};
+
+template <int Cells>
+struct MaskFor {
+    using type = std::conditional_t<(Cells <= 16), uint16_t,
+                 std::conditional_t<(Cells <= 32), uint32_t,
+                 std::conditional_t<(Cells <= 64), uint64_t, WideMask<(Cells + 63) / 64>>>>;
+};
+
+template <typename Mask>
+constexpr bool maskTest(const Mask& mask, int index) {
+    return ((mask >> index) & 1) != 0;
+}
+
+template <int Words>
+constexpr bool maskTest(const WideMask<Words>& mask, int index) {
+    return ((mask.words[index >> 6] >> (index & 63)) & 1) != 0;
+}
+
+template <typename Mask>
+constexpr void maskSet(Mask& mask, int index) {
+    mask = static_cast<Mask>(mask | (static_cast<Mask>(1) << index));
+}
+
+template <int Words>
+constexpr void maskSet(WideMask<Words>& mask, int index) {
+    mask.words[index >> 6] |= 1ull << (index & 63);
+}
+
+template <typename Mask>
+constexpr void maskReset(Mask& mask, int index) {
+    mask = static_cast<Mask>(mask & ~(static_cast<Mask>(1) << index));
+}
+
+template <int Words>
+constexpr void maskReset(WideMask<Words>& mask, int index) {
+    mask.words[index >> 6] &= ~(1ull << (index & 63));
+}
+
+template <typename Mask>
+inline int maskCount(const Mask& mask) {
+    return countBits(static_cast<uint64_t>(mask));
+}
+
+template <int Words>
+inline int maskCount(const WideMask<Words>& mask) {
+    int count = 0;
+    for (uint64_t word : mask.words) count += countBits(word);
+    return count;
+}
+
+// Every one of the first cells squares.
+template <typename Mask>
+constexpr Mask makeFullMask(int cells) {
+    Mask mask{};
+    for (int i = 0; i < cells; ++i) maskSet(mask, i);
+    return mask;
+}
+
+// --- Geometry Tables ---
+template <int N, int K>
+struct BoardGeometry {
+    static_assert(N >= MIN_BOARD_SIZE && N <= MAX_BOARD_SIZE && K >= 3 && K <= N, "unsupported board geometry");
+    static constexpr int CELLS = N * N;
+    static constexpr int SPAN = N - K + 1; // Starting squares for a line along one row
+    static constexpr int LINE_COUNT = 2 * N * SPAN + 2 * SPAN * SPAN;
+    static constexpr int LINES_PER_CELL = 4 * (K < SPAN ? K : SPAN); // Most lines through one square
+    using Mask = typename MaskFor<CELLS>::type;
+    static constexpr Mask FULL = makeFullMask<Mask>(CELLS);
+};
+
+// Row and column steps. Direction d + 4 is the opposite of direction d.
+const int DIRECTION_COUNT = 8;
+constexpr int DIRECTION_STEPS[DIRECTION_COUNT][2] = {
+    { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 }, { 0, -1 }, { -1, 0 }, { -1, -1 }, { -1, 1 }
+};
+
+template <int N, int K>
+struct LineTable {
+    using Geometry = BoardGeometry<N, K>;
+    typename Geometry::Mask masks[Geometry::LINE_COUNT];
+    // The lines through each square, padded with repeats to a fixed count so
+    // the win test is a loop of known length with no early exit.
+    typename Geometry::Mask through[Geometry::CELLS][Geometry::LINES_PER_CELL];
+};
+
+// Rows, then columns, then both diagonals; for 3x3 this is exactly the old
+// hand-written wins[8][3] table.
+template <int N, int K>
+constexpr LineTable<N, K> makeLineTable() {
+    LineTable<N, K> table{};
+    int throughCount[N * N] = {};
+    int line = 0;
+    for (int d = 0; d < 4; ++d) {
+        int dr = DIRECTION_STEPS[d][0];
+        int dc = DIRECTION_STEPS[d][1];
+        for (int row = 0; row < N; ++row) {
+            for (int col = 0; col < N; ++col) {
+                int endRow = row + (K - 1) * dr;
+                int endCol = col + (K - 1) * dc;
+                if (endRow < 0 || endRow >= N || endCol < 0 || endCol >= N) continue;
+                for (int k = 0; k < K; ++k) {
+                    maskSet(table.masks[line], (row + k * dr) * N + (col + k * dc));
+                }
+                for (int k = 0; k < K; ++k) {
+                    int cell = (row + k * dr) * N + (col + k * dc);
+                    table.through[cell][throughCount[cell]++] = table.masks[line];
+                }
+                ++line;
+            }
+        }
+    }
+    for (int cell = 0; cell < N * N; ++cell) {
+        for (int j = throughCount[cell]; j < BoardGeometry<N, K>::LINES_PER_CELL; ++j) {
+            table.through[cell][j] = table.through[cell][0];
+        }
+    }
+    return table;
+}
+
+template <int N>
+struct NeighbourTable {
+    int16_t next[N * N][DIRECTION_COUNT]; // -1 off the edge of the board
+};
+
+template <int N>
+constexpr NeighbourTable<N> makeNeighbourTable() {
+    NeighbourTable<N> table{};
+    for (int cell = 0; cell < N * N; ++cell) {
+        for (int d = 0; d < DIRECTION_COUNT; ++d) {
+            int row = cell / N + DIRECTION_STEPS[d][0];
+            int col = cell % N + DIRECTION_STEPS[d][1];
+            bool onBoard = row >= 0 && row < N && col >= 0 && col < N;
+            table.next[cell][d] = static_cast<int16_t>(onBoard ? row * N + col : -1);
+        }
+    }
+    return table;
+}
+
+// The eight rotations and reflections of the square, as square permutations.
+const int SYMMETRY_COUNT = 8;
+
+template <int N>
+struct SymmetryTable {
+    uint16_t map[SYMMETRY_COUNT][N * N];
+};
+
+template <int N>
+constexpr SymmetryTable<N> makeSymmetryTable() {
+    SymmetryTable<N> table{};
+    for (int cell = 0; cell < N * N; ++cell) {
+        int r = cell / N;
+        int c = cell % N;
+        int m = N - 1;
+        const int images[SYMMETRY_COUNT][2] = {
+            { r, c }, { c, m - r }, { m - r, m - c }, { m - c, r },  // Rotations
+            { r, m - c }, { m - r, c }, { c, r }, { m - c, m - r }   // Reflections
+        };
+        for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+            table.map[s][cell] = static_cast<uint16_t>(images[s][0] * N + images[s][1]);
+        }
+    }
+    return table;
+}
+
+template <int N, int K>
+struct BoardTables {
+    static constexpr LineTable<N, K> lines = makeLineTable<N, K>();
+    static constexpr NeighbourTable<N> neighbours = makeNeighbourTable<N>();
+    static constexpr SymmetryTable<N> symmetries = makeSymmetryTable<N>();
+};
+
+// --- Fixed-Size Board ---
+// Boards wider than 64 squares also count their occupied squares, as the
+// runtime Board does, so the draw test is one compare instead of a pass
+// over every word. Narrower ones compare one mask and carry no count.
+template <bool Counted>
+struct FilledCount {};
+
+template <>
+struct FilledCount<true> {
+    int filled = 0; // Occupied squares
+};
+
+template <int N, int K>
+struct FixedBoard : FilledCount<(N * N > 64)> {
+    using Geometry = BoardGeometry<N, K>;
+    using Mask = typename Geometry::Mask;
+    static constexpr int size = N;
+    static constexpr int winLength = K;
+
+    Mask p1{};           // Squares held by Blue Side (X)
+    Mask p2{};           // Squares held by Red Side (O)
+    uint8_t toMove = 1;  // 1 = Blue Side, 2 = Red Side
+};
+
+using Board3x3 = FixedBoard<3, 3>;
+using Board4x4 = FixedBoard<4, 4>;
+using Board15x15 = FixedBoard<15, 5>;
+
+template <int N, int K>
+constexpr int cellCount(const FixedBoard<N, K>&) {
+    return N * N;
+}
+
+template <int N, int K>
+constexpr bool isClassicBoard(const FixedBoard<N, K>&) {
+    return N == CLASSIC_SIZE && K == CLASSIC_SIZE;
+}
+
+template <int N, int K>
+inline const typename FixedBoard<N, K>::Mask& marksOf(const FixedBoard<N, K>& board, char playerSymbol) {
+    return playerSymbol == P1_SYMBOL ? board.p1 : board.p2;
+}
+
+// The low 9 bits of a side's marks, as for the runtime Board.
+template <int N, int K>
+inline uint16_t classicMarks(const FixedBoard<N, K>& board, char playerSymbol) {
+    if constexpr (N * N <= 64) return static_cast<uint16_t>(marksOf(board, playerSymbol) & 0x1FF);
+    else return static_cast<uint16_t>(marksOf(board, playerSymbol).words[0] & 0x1FF);
+}
+
+template <int N, int K>
+inline bool isEmptySquare(const FixedBoard<N, K>& board, int index) {
+    return !maskTest(board.p1, index) && !maskTest(board.p2, index);
+}
+
+template <int N, int K>
+inline char cellSymbol(const FixedBoard<N, K>& board, int index) {
+    if (maskTest(board.p1, index)) return P1_SYMBOL;
+    if (maskTest(board.p2, index)) return P2_SYMBOL;
+    return '\0';
+}
+
+template <int N, int K>
+inline void setCell(FixedBoard<N, K>& board, int index, char playerSymbol) {
+    if constexpr (N * N > 64) {
+        if (isEmptySquare(board, index)) ++board.filled;
+    }
+    if (playerSymbol == P1_SYMBOL) {
+        maskSet(board.p1, index);
+        maskReset(board.p2, index);
+    }
+    else {
+        maskSet(board.p2, index);
+        maskReset(board.p1, index);
+    }
+}
+
+template <int N, int K>
+inline void clearCell(FixedBoard<N, K>& board, int index) {
+    if constexpr (N * N > 64) {
+        if (!isEmptySquare(board, index)) --board.filled;
+    }
+    maskReset(board.p1, index);
+    maskReset(board.p2, index);
+}
+
+template <int N, int K>
+inline bool checkDraw(const FixedBoard<N, K>& board) {
+    if constexpr (N * N <= 64) return (board.p1 | board.p2) == BoardGeometry<N, K>::FULL;
+    else return board.filled == N * N;
+}
+
+// True if marks covers any of the lines, expanded at compile time into one
+// AND and compare per line with no branches.
+template <typename Mask, int... J>
+inline bool anyLineFull(Mask marks, const Mask (&lines)[sizeof...(J)], std::integer_sequence<int, J...>) {
+    return (0 | ... | static_cast<int>((marks & lines[J]) == lines[J])) != 0;
+}
+
+// Same contract as makesLine(const Board&, ...): would holding index give
+// playerSymbol K in a row? Narrow boards OR the square in and compare
+// against the few line masks through it; wide boards walk the neighbours.
+template <int N, int K>
+inline bool makesLine(const FixedBoard<N, K>& board, int index, char playerSymbol) {
+    using Geometry = BoardGeometry<N, K>;
+    using Mask = typename Geometry::Mask;
+    if constexpr (Geometry::CELLS <= 64) {
+        constexpr const LineTable<N, K>& table = BoardTables<N, K>::lines;
+        Mask marks = marksOf(board, playerSymbol);
+        maskSet(marks, index);
+        return anyLineFull(marks, table.through[index], std::make_integer_sequence<int, Geometry::LINES_PER_CELL>());
+    }
+    else {
+        constexpr const NeighbourTable<N>& table = BoardTables<N, K>::neighbours;
+        const Mask& marks = marksOf(board, playerSymbol);
+        for (int d = 0; d < DIRECTION_COUNT / 2; ++d) {
+            int run = 1;
+            for (int cell = table.next[index][d]; run < K && cell >= 0 && maskTest(marks, cell); cell = table.next[cell][d]) ++run;
+            for (int cell = table.next[index][d + 4]; run < K && cell >= 0 && maskTest(marks, cell); cell = table.next[cell][d + 4]) ++run;
+            if (run >= K) return true;
+        }
+        return false;
+    }
+}
+
+template <int N, int K>
+inline bool checkWinAt(const FixedBoard<N, K>& board, int index, char playerSymbol) {
+    return index >= 0 && makesLine(board, index, playerSymbol);
+}
+
+// Lowest empty square that would complete a line for playerSymbol, or -1.
+// On narrow boards this is one branch-free pass over the line masks.
+template <int N, int K>
+inline int findCompletingSquare(const FixedBoard<N, K>& board, char playerSymbol) {
+    using Geometry = BoardGeometry<N, K>;
+    using Mask = typename Geometry::Mask;
+    if constexpr (Geometry::CELLS <= 64) {
+        constexpr const LineTable<N, K>& table = BoardTables<N, K>::lines;
+        Mask marks = marksOf(board, playerSymbol);
+        Mask occupiedSquares = static_cast<Mask>(board.p1 | board.p2);
+        uint64_t result = 0;
+        for (Mask line : table.masks) {
+            Mask missing = static_cast<Mask>(line & ~marks);
+            bool single = missing != 0 && (missing & (missing - 1)) == 0;
+            bool open = (missing & occupiedSquares) == 0;
+            result |= (single && open) ? missing : 0;
+        }
+        return result != 0 ? lowestBit(result) : -1;
+    }
+    else {
+        for (int i = 0; i < N * N; ++i) {
+            if (isEmptySquare(board, i) && makesLine(board, i, playerSymbol)) return i;
+        }
+        return -1;
+    }
+}
+
+// --- Dispatch ---
+// Calls visit with an empty board of the best matching type. Everything the
+// visitor does with it is compiled for that geometry.
+template <typename Visitor>
+auto withBoard(int size, int winLength, Visitor&& visit) {
+    if (size == 3 && winLength == 3) return visit(Board3x3());
+    if (size == 4 && winLength == 4) return visit(Board4x4());
+    if (size == 15 && winLength == 5) return visit(Board15x15());
+    return visit(Board(size, winLength));
+}
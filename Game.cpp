@@ -0,0 +1,632 @@
+#include "Game.h"
+#include <cmath>
+#include "Metrics.h"
+
+namespace {
+
+// One row of the hint panel: every square's value as a percentage, placing
+// in white and conquering in yellow, the best of each in green.
+void printHintRow(Screen& screen, const MoveHints& hints, int row, int n) {
+    screen << "     ";
+    for (int col = 0; col < n; ++col) {
+        int i = row * n + col;
+        bool placing = (hints.place[i] != HINT_NONE);
+        float value = placing ? hints.place[i] : hints.conquer[i];
+        if (value == HINT_NONE) {
+            screen.setColor(COLOR_GREY);
+            screen << "   .";
+            continue;
+        }
+        bool best = (i == hints.bestPlace || i == hints.bestConquer);
+        screen.setColor(best ? COLOR_GREEN : placing ? COLOR_WHITE : COLOR_YELLOW);
+        std::string percent = std::to_string(std::lround(value * 100.0f));
+        screen << std::string(4 - percent.size(), ' ') << percent;
+    }
+    screen.setColor(COLOR_WHITE);
+}
+
+std::string squareRange(const Board& board) {
+    return "(1-" + std::to_string(cellCount(board)) + ")";
+}
+
+const char* coinFace(int toss) {
+    return (toss == 1) ? "Heads!" : "Tails!";
+}
+
+} // namespace
+
+// --- Board Rendering ---
+// With hints, each row of the grid is followed by the same row of the panel.
+void printBoard(Screen& screen, const Board& board, const MoveHints* hints) {
+    METRICS_SCOPE(BoardDraw);
+    // Every square is five columns wide, enough for labels up to 361. Boards
+    // past 5x5 drop the blank spacer rows so they still fit on screen.
+    const int cellWidth = 5;
+    int n = board.size;
+    bool roomy = (n <= 5);
+    std::string spacer, underline;
+    for (int col = 0; col < n; ++col) {
+        spacer += std::string(cellWidth, ' ');
+        underline += std::string(cellWidth, '_');
+        if (col < n - 1) {
+            spacer += '|';
+            underline += '|';
+        }
+    }
+
+    screen.setColor(COLOR_WHITE);
+    screen << "\n";
+    for (int row = 0; row < n; ++row) {
+        if (roomy) screen << spacer << "\n";
+        for (int col = 0; col < n; ++col) {
+            int i = row * n + col;
+            char cell = cellSymbol(board, i);
+            std::string label = (cell != '\0') ? std::string(1, cell) : std::to_string(i + 1);
+            int left = (cellWidth - static_cast<int>(label.size())) / 2;
+            screen << std::string(left, ' ');
+            if (cell == P1_SYMBOL) screen.setColor(COLOR_BLUE);
+            else if (cell == P2_SYMBOL) screen.setColor(COLOR_RED);
+            else screen.setColor(COLOR_GREY);
+            screen << label;
+            screen.setColor(COLOR_WHITE);
+            if (col < n - 1) screen << std::string(cellWidth - left - label.size(), ' ') << "|";
+        }
+        if (hints) printHintRow(screen, *hints, row, n);
+        screen << "\n";
+        if (row < n - 1) screen << underline << "\n";
+        else if (roomy) screen << spacer << "\n";
+    }
+    screen << "\n";
+    if (hints) {
+        screen.setColor(COLOR_GREY);
+        screen << "Hints for " << hints->mover << ": % chance to win (a draw counts half) by placing there, or in yellow\n"
+               << "by trying to conquer it on a power turn. ";
+        if (hints->exact) screen << "Exact, from the solved table";
+        else screen << "Estimated, " << hints->rescored << " squares re-scored";
+        screen << " in " << static_cast<int>(std::lround(hints->microseconds)) << " us.\n";
+        screen.setColor(COLOR_WHITE);
+    }
+}
+
+// --- Animation Timer ---
+void AnimationTimer::start(int milliseconds) {
+    int scaled = (speed > 0.0) ? static_cast<int>(std::lround(milliseconds / speed)) : 0;
+    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(scaled);
+    active = true;
+}
+
+int AnimationTimer::remainingMs() const {
+    auto left = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    return left.count() > 0 ? static_cast<int>(left.count()) : 0;
+}
+
+// --- Turn State Machine ---
+Game::Game(Screen& screen, const Board& board, Rng& rng, const Strategy* ai, double animationSpeed)
+    : screen(screen), board(board), rng(rng), ai(ai), timer(animationSpeed) {}
+
+void Game::start() {
+    history.clear();
+    lastMover = 0;
+    winner = -1;
+    enter(Phase::RollIntro);
+}
+
+void Game::animate(int milliseconds, Phase next) {
+    afterAnimation = next;
+    ++animations;
+    timer.start(milliseconds);
+}
+
+void Game::onTimer() {
+    timer.stop();
+    enter(afterAnimation);
+}
+
+void Game::enter(Phase next) {
+    phase = next;
+    switch (phase) {
+    // --- Starting Dice Roll ---
+    case Phase::RollIntro:
+        screen.clear();
+        screen << "Let's see who goes first. The dice will decide!\n";
+        animate(2000, Phase::BlueRolls);
+        break;
+    case Phase::BlueRolls:
+        screen << "\nPlayer 1 (";
+        screen.setColor(COLOR_BLUE);
+        screen << "Blue Side";
+        screen.setColor(COLOR_WHITE);
+        screen << ") is rolling...";
+        animate(1500, Phase::RedRolls);
+        break;
+    case Phase::RedRolls:
+        p1Roll = rng.roll(6);
+        screen << " a " << p1Roll << "!\n";
+        screen << (ai != nullptr ? "AI (Red Side)" : "Player 2 (Red Side)") << " is rolling...";
+        animate(1500, Phase::RollResult);
+        break;
+    case Phase::RollResult:
+        p2Roll = rng.roll(6);
+        screen << " a " << p2Roll << "!\n\n";
+        if (p1Roll == p2Roll) {
+            screen.setColor(COLOR_YELLOW);
+            screen << "It's a tie! Rerolling...\n";
+            animate(2000, Phase::BlueRolls);
+            break;
+        }
+        if (record) {
+            record->blueRoll = static_cast<uint8_t>(p1Roll);
+            record->redRoll = static_cast<uint8_t>(p2Roll);
+        }
+        if (p1Roll > p2Roll) {
+            board.toMove = 1;
+            screen.setColor(COLOR_BLUE);
+            screen << "Blue Side wins the roll and will go first!\n";
+        }
+        else {
+            board.toMove = 2;
+            screen.setColor(COLOR_RED);
+            screen << (ai != nullptr ? "The AI" : "Red Side") << " wins the roll and will go first!\n";
+        }
+        screen.setColor(COLOR_WHITE);
+        screen << "\nPress Enter to start...";
+        await(Phase::StartPrompt);
+        break;
+
+    // --- Turn Start ---
+    case Phase::TurnStart:
+        screen.clear();
+        printBoard(screen, board, hints ? &hints->evaluate(board, moverSymbol()) : nullptr);
+        claimedSquare = -1;
+        targetSquare = -1;
+        conquering = false;
+        coinCall = coinResult = 0;
+        defenseCall = defenseToss = 0;
+        if (aiToMove()) {
+            screen.setColor(COLOR_RED);
+            screen << "AI's Turn (O)\n";
+            animate(1000, Phase::AiCoinToss);
+            break;
+        }
+        screen.setColor(board.toMove == 1 ? COLOR_BLUE : COLOR_RED);
+        screen << (board.toMove == 1 ? "Blue Side's Turn (X)\n" : "Red Side's Turn (O)\n");
+        screen.setColor(COLOR_WHITE);
+        screen << "First, the coin toss. Call it! (1 for Heads, 2 for Tails): ";
+        await(Phase::CoinCall);
+        break;
+
+    // --- Human Turn ---
+    case Phase::CoinResult:
+        screen << " It's " << coinFace(coinResult) << "\n\n";
+        powerTurn = (coinCall == coinResult);
+        if (powerTurn) {
+            screen.setColor(COLOR_GREEN);
+            screen << "You won the toss! It's a POWER TURN!\n";
+            screen.setColor(COLOR_WHITE);
+            screen << "1. Place mark | 2. Conquer opponent's square\nYour choice: ";
+            await(Phase::ActionChoice);
+        }
+        else {
+            screen.setColor(COLOR_YELLOW);
+            screen << "You lost the toss. It's a normal turn.\n";
+            screen.setColor(COLOR_WHITE);
+            screen << "Choose an empty square to place your mark " << squareRange(board) << ": ";
+            await(Phase::PlaceSquare);
+        }
+        break;
+
+    // --- Defense Toss ---
+    case Phase::DefenseStart:
+        if (ai != nullptr && board.toMove == 1) { // AI is defending
+            screen.setColor(COLOR_RED);
+            screen << "The AI is making its defense call...\n";
+            defenseCall = rng.roll(2);
+            animate(2000, Phase::DefenseToss);
+        }
+        else { // Human is defending
+            screen.setColor(board.toMove == 1 ? COLOR_RED : COLOR_BLUE);
+            screen << "Defender, call it! (1 for Heads, 2 for Tails): ";
+            await(Phase::DefenseCall);
+        }
+        break;
+    case Phase::DefenseToss:
+        defenseToss = rng.roll(2);
+        screen << "The defense toss is...";
+        animate(2000, Phase::DefenseResult);
+        break;
+    case Phase::DefenseResult: {
+        bool aiAttacking = aiToMove();
+        screen << " " << coinFace(defenseToss) << "\n";
+        if (defenseCall == defenseToss) {
+            METRICS_COUNT(DefenseSaves);
+            screen.setColor(COLOR_GREEN);
+            screen << (aiAttacking ? "\nDEFENSE SUCCESSFUL! You saved your square!\n" : "\nDEFENSE SUCCESSFUL! The square is safe!\n");
+        }
+        else {
+            screen.setColor(COLOR_RED);
+            screen << (aiAttacking ? "\nDEFENSE FAILED! The AI conquered your square!\n" : "\nDEFENSE FAILED! The square has been conquered!\n");
+            claimedSquare = targetSquare;
+            METRICS_COUNT(ConquerSuccesses);
+        }
+        animate(2500, Phase::TurnEnd);
+        break;
+    }
+
+    // --- AI Turn ---
+    case Phase::AiCoinToss:
+        screen.setColor(COLOR_WHITE);
+        screen << "The AI is calling the coin toss...";
+        coinCall = rng.roll(2);
+        animate(2000, Phase::AiCoinResult);
+        break;
+    case Phase::AiCoinResult:
+        coinResult = rng.roll(2);
+        screen << " It's " << coinFace(coinResult) << "\n\n";
+        powerTurn = (coinCall == coinResult);
+        if (powerTurn) {
+            screen.setColor(COLOR_GREEN);
+            screen << "The AI won the toss! It's a POWER TURN!\n";
+        }
+        else {
+            screen.setColor(COLOR_YELLOW);
+            screen << "The AI lost the toss. It's a normal turn.\n";
+        }
+        animate(1500, Phase::AiThinking);
+        break;
+    case Phase::AiConquer:
+        screen.setColor(COLOR_YELLOW);
+        screen << "\nYOUR CHANCE TO DEFEND!\n";
+        screen.setColor(COLOR_BLUE);
+        screen << "Call it! (1 for Heads, 2 for Tails): ";
+        await(Phase::DefenseCall);
+        break;
+    case Phase::AiPlace:
+        claimedSquare = targetSquare;
+        screen << "The AI places its mark on square " << targetSquare + 1 << ".\n";
+        animate(1500, Phase::TurnEnd);
+        break;
+
+    // --- Check for Game Over ---
+    // The claimed square is only taken here, together with passing the turn,
+    // so the whole turn can be taken back in one step.
+    case Phase::TurnEnd: {
+        recordTurn();
+        METRICS_COUNT(Moves);
+        int mover = board.toMove;
+        char symbol = moverSymbol();
+        lastTurn = currentTurn();
+        lastMover = mover;
+        history.push(makeMove(board, claimedSquare, symbol));
+        bool won, drawn;
+        {
+            METRICS_SCOPE(RuleCheck);
+            // Only a line through the square just claimed can have been completed
+            won = checkWinAt(board, claimedSquare, symbol);
+            drawn = !won && checkDraw(board);
+        }
+        if (won || drawn) {
+            METRICS_COUNT(Games);
+            winner = won ? mover : 0;
+            if (record) record->finish(board, winner);
+            screen.clear();
+            printBoard(screen, board);
+            if (won && mover == 1) {
+                screen.setColor(COLOR_BLUE);
+                screen << "\nBLUE SIDE IS VICTORIOUS!\n";
+            }
+            else if (won) {
+                screen.setColor(COLOR_RED);
+                screen << "\nRED SIDE IS VICTORIOUS!\n";
+            }
+            else {
+                screen.setColor(COLOR_YELLOW);
+                screen << "\nTHE BATTLE ENDS IN A DRAW!\n";
+            }
+            screen.setColor(COLOR_WHITE);
+            screen << "\n\nThanks for playing EchoGrid!\n";
+            await(Phase::Farewell);
+            break;
+        }
+        enter(Phase::TurnStart);
+        break;
+    }
+
+    default: // Phases that only wait for input
+        break;
+    }
+}
+
+TurnAction Game::think() {
+    METRICS_SCOPE(AiThink);
+    return ai->chooseAction(board, P2_SYMBOL, powerTurn, rng);
+}
+
+void Game::onDecision(const TurnAction& action) {
+    printAISummary(powerTurn ? COLOR_GREEN : COLOR_YELLOW);
+    printHintVerdict(action, powerTurn ? COLOR_GREEN : COLOR_YELLOW);
+    targetSquare = action.square;
+    conquering = powerTurn && action.conquer;
+    // Held to the rules a player and playGame() are: a conquest needs an
+    // opponent's square and a placement an empty one, or the turn is forfeited
+    bool onBoard = targetSquare >= 0 && targetSquare < cellCount(board);
+    bool legal = onBoard && (conquering ? cellSymbol(board, targetSquare) == P1_SYMBOL : isEmptySquare(board, targetSquare));
+    if (!legal) {
+        if (conquering) METRICS_COUNT(ConquerAttempts);
+        METRICS_COUNT(Forfeits);
+        screen.setColor(COLOR_RED);
+        screen << (conquering ? "The AI tried to conquer a square that isn't yours. Its turn is forfeited!\n"
+                              : "The AI has no square to place its mark on. Its turn is forfeited!\n");
+        animate(2500, Phase::TurnEnd);
+    }
+    else if (conquering) {
+        METRICS_COUNT(ConquerAttempts);
+        screen << "The AI chooses to CONQUER square " << targetSquare + 1 << "!\n";
+        animate(2000, Phase::AiConquer);
+    }
+    else if (powerTurn) {
+        screen << "The AI chooses to place a mark.\n";
+        animate(1000, Phase::AiPlace);
+    }
+    else {
+        enter(Phase::AiPlace);
+    }
+}
+
+Game::Prompt Game::prompt() const {
+    if (timer.running()) return Prompt::None; // phase is still the one that started it
+    switch (phase) {
+    case Phase::StartPrompt: return Prompt::Start;
+    case Phase::CoinCall: return Prompt::Call;
+    case Phase::ActionChoice: return Prompt::Action;
+    case Phase::PlaceSquare: return Prompt::Place;
+    case Phase::ConquerSquare: return Prompt::Conquer;
+    case Phase::DefenseCall: return Prompt::Defense;
+    case Phase::Farewell: return Prompt::Farewell;
+    default: return Prompt::None;
+    }
+}
+
+int Game::promptPlayer() const {
+    switch (prompt()) {
+    case Prompt::None:
+    case Prompt::Start:
+    case Prompt::Farewell:
+        return 0;
+    case Prompt::Defense:
+        return (board.toMove == 1) ? 2 : 1;
+    default:
+        return board.toMove;
+    }
+}
+
+void Game::onInput(const std::string& line) {
+    screen.echoInput(line);
+    int choice = 0;
+    switch (phase) {
+    case Phase::StartPrompt:
+        enter(Phase::TurnStart);
+        break;
+    case Phase::CoinCall:
+        if (undoAllowed && (line == "u" || line == "U")) {
+            takeBack();
+            break;
+        }
+        if (!readChoice(line, choice, "Invalid choice. Please enter 1 or 2: ")) break;
+        coinCall = choice;
+        coinResult = rng.roll(2);
+        screen << "Flipping the coin...";
+        animate(2000, Phase::CoinResult);
+        break;
+    case Phase::ActionChoice:
+        if (!readChoice(line, choice, "Invalid choice. Enter 1 or 2: ")) break;
+        if (choice == 1) { // Place
+            screen << "Choose an empty square " << squareRange(board) << ": ";
+            await(Phase::PlaceSquare);
+        }
+        else { // Conquer
+            conquering = true;
+            screen << "Choose an opponent's square to CONQUER " << squareRange(board) << ": ";
+            await(Phase::ConquerSquare);
+        }
+        break;
+    case Phase::PlaceSquare:
+        if (!readSquare(line, true, targetSquare)) break;
+        claimedSquare = targetSquare;
+        enter(Phase::TurnEnd);
+        break;
+    case Phase::ConquerSquare:
+        if (!readSquare(line, false, targetSquare)) break;
+        METRICS_COUNT(ConquerAttempts);
+        if (cellSymbol(board, targetSquare) == ((board.toMove == 1) ? P2_SYMBOL : P1_SYMBOL)) {
+            screen.setColor(COLOR_YELLOW);
+            screen << "\nTHE DEFENDER HAS A CHANCE TO SAVE THE SQUARE!\n";
+            animate(1500, Phase::DefenseStart);
+        }
+        else {
+            screen.setColor(COLOR_RED);
+            screen << "\nInvalid target! That's not an opponent's square.\n";
+            screen << "Your turn is forfeited!\n";
+            METRICS_COUNT(Forfeits);
+            animate(2500, Phase::TurnEnd);
+        }
+        break;
+    case Phase::DefenseCall:
+        if (!readChoice(line, choice, "Invalid call. 1 for Heads, 2 for Tails: ")) break;
+        defenseCall = choice;
+        enter(Phase::DefenseToss);
+        break;
+    case Phase::Farewell:
+        phase = Phase::Finished;
+        break;
+    default: // Not expecting input; an animation is running
+        break;
+    }
+}
+
+// A 1 or 2 answer; anything else asks again with retry.
+bool Game::readChoice(const std::string& line, int& choice, const char* retry) {
+    if (parseNumber(line, choice) && (choice == 1 || choice == 2)) return true;
+    screen << retry;
+    return false;
+}
+
+// A square number from the player, as an index.
+bool Game::readSquare(const std::string& line, bool isEmptyRequired, int& square) {
+    int move = 0;
+    if (!parseNumber(line, move)) {
+        screen << "Invalid input. Please enter a number: ";
+        return false;
+    }
+    if (move < 1 || move > cellCount(board)) {
+        screen << "Invalid input. Please enter a number between 1 and " << cellCount(board) << ": ";
+        return false;
+    }
+    if (isEmptyRequired && !isEmptySquare(board, move - 1)) {
+        screen << "That square is already taken. Choose an empty one: ";
+        return false;
+    }
+    square = move - 1;
+    return true;
+}
+
+TurnRecord Game::currentTurn() const {
+    TurnRecord turn;
+    turn.coinCall = static_cast<uint8_t>(coinCall);
+    turn.coinResult = static_cast<uint8_t>(coinResult);
+    turn.conquer = conquering;
+    turn.defenseCall = static_cast<uint8_t>(defenseCall);
+    turn.defenseToss = static_cast<uint8_t>(defenseToss);
+    turn.square = static_cast<int16_t>(targetSquare);
+    return turn;
+}
+
+void Game::recordTurn() {
+    if (record != nullptr) record->turns.push_back(currentTurn());
+}
+
+// The tosses are rolled when they start, but the players only see them
+// after the animation that follows, and neither should anyone watching.
+GameView Game::view() const {
+    GameView view;
+    view.board = board;
+    view.toMove = board.toMove;
+    view.turn = currentTurn();
+    view.lastTurn = lastTurn;
+    view.lastMover = lastMover;
+    if (lastMover == 0) view.lastTurn.coinCall = view.lastTurn.coinResult = 0;
+    view.winner = winner;
+    switch (phase) {
+    case Phase::RollIntro:
+    case Phase::BlueRolls:
+    case Phase::RedRolls:
+    case Phase::RollResult:
+    case Phase::StartPrompt:
+        view.stage = GameView::Stage::Rolling;
+        break;
+    case Phase::Farewell:
+    case Phase::Finished:
+        view.stage = GameView::Stage::Over;
+        view.toMove = lastMover;
+        break;
+    case Phase::DefenseStart:
+    case Phase::DefenseCall:
+    case Phase::DefenseToss:
+    case Phase::DefenseResult:
+    case Phase::AiConquer:
+        view.stage = GameView::Stage::Defense;
+        break;
+    default:
+        view.stage = GameView::Stage::Turn;
+        break;
+    }
+    bool coinLanded = (phase != Phase::CoinCall && phase != Phase::AiCoinToss);
+    if (view.stage == GameView::Stage::Rolling || !coinLanded) view.turn.coinResult = 0;
+    if (view.stage == GameView::Stage::Rolling) view.turn.coinCall = 0;
+    if (phase != Phase::DefenseResult) view.turn.defenseToss = 0;
+    return view;
+}
+
+// Back to the start of the player's previous turn, taking back the reply to
+// it as well. Turns alternate, so those are the last two in the history.
+void Game::takeBack() {
+    const int turns = 2;
+    if (history.size() < turns) {
+        screen << "There is no turn of yours to take back. Call it! (1 for Heads, 2 for Tails): ";
+        return;
+    }
+    for (int t = 0; t < turns; ++t) {
+        unmakeMove(board, history.back());
+        history.pop();
+        if (record && !record->turns.empty()) record->turns.pop_back();
+    }
+    lastMover = 0; // The turn before those is not kept
+    enter(Phase::TurnStart);
+}
+
+// Search statistics in grey (only the MCTS player has any), then back to color.
+void Game::printAISummary(int color) {
+    std::string summary = ai->summary();
+    if (summary.empty()) return;
+    screen.setColor(COLOR_GREY);
+    screen << "(" << summary << ")\n";
+    screen.setColor(color);
+}
+
+// What the hints made of the AI's choice, in grey, then back to color.
+void Game::printHintVerdict(const TurnAction& action, int color) {
+    if (hints == nullptr) return;
+    const MoveHints& values = hints->evaluate(board, P2_SYMBOL);
+    bool conquer = powerTurn && action.conquer;
+    int square = action.square;
+    float chosen = (square < 0) ? HINT_NONE : conquer ? values.conquer[square] : values.place[square];
+    int best = values.bestPlace;
+    bool bestConquers = false;
+    if (powerTurn && values.bestConquer >= 0 && (best < 0 || values.conquer[values.bestConquer] > values.place[best])) {
+        best = values.bestConquer;
+        bestConquers = true;
+    }
+    float bestValue = (best < 0) ? HINT_NONE : bestConquers ? values.conquer[best] : values.place[best];
+    auto percent = [](float value) { return std::to_string(std::lround(value * 100.0f)) + "%"; };
+    screen.setColor(COLOR_GREY);
+    if (chosen == HINT_NONE) screen << "(Hints: the AI's choice is not a legal action";
+    else screen << "(Hints: the AI's choice is worth " << percent(chosen);
+    if (best >= 0 && (chosen == HINT_NONE || bestValue > chosen)) {
+        screen << "; the best was " << (bestConquers ? "conquering " : "placing on ") << best + 1 << " at " << percent(bestValue);
+    }
+    screen << ")\n";
+    screen.setColor(color);
+}
+
+// --- Event Loop ---
+void runGame(Game& game, InputSource& input, Screen& screen) {
+    uint64_t animation = 0;
+    uint64_t firstLineDuring = 0; // Lines numbered from here arrived during the animation
+    game.start();
+    while (!game.finished()) {
+        screen.present();
+        if (game.thinking()) {
+            game.onDecision(game.think());
+        }
+        else if (game.animating()) {
+            if (game.animationNumber() != animation) {
+                animation = game.animationNumber();
+                firstLineDuring = input.linesReceived();
+            }
+            if (input.waitForLine(game.animationRemainingMs()) && input.nextLineNumber() >= firstLineDuring) {
+                // The terminal echoed it mid-animation, not at a prompt.
+                screen.noteStrayInput();
+                if (input.peekLine().empty()) input.discardLine();
+            }
+            game.onTimer();
+        }
+        else {
+            bool answered;
+            {
+                METRICS_SCOPE(InputWait);
+                answered = input.waitForLine(-1);
+            }
+            if (!answered) return; // Input ended
+            game.onInput(input.takeLine());
+        }
+    }
+}
@@ -0,0 +1,158 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include "Board.h"
+#include "GameRecord.h"
+#include "Hints.h"
+#include "Input.h"
+#include "Move.h"
+#include "Rng.h"
+#include "Screen.h"
+#include "Simulation.h"
+
+// --- Board Rendering ---
+// Draws the grid into the frame, numbering the empty squares, with the hint
+// panel beside it if hints are given.
+void printBoard(Screen& screen, const Board& board, const MoveHints* hints = nullptr);
+
+// --- Animation Timer ---
+// The pauses between the steps of a turn ("Flipping the coin...", then
+// "It's Heads!"). speed scales every delay (2 = twice as fast); 0 turns
+// them off, which is what --fast does.
+class AnimationTimer {
+public:
+    explicit AnimationTimer(double speed = 1.0) : speed(speed) {}
+
+    void start(int milliseconds);
+    void stop() { active = false; }
+    bool running() const { return active; }
+    int remainingMs() const; // 0 once it is due
+
+private:
+    double speed;
+    bool active = false;
+    std::chrono::steady_clock::time_point deadline;
+};
+
+// --- Game View ---
+// Where a game stands between events, for those watching it rather than
+// playing it. A toss only shows once it has landed on the players' screens.
+struct GameView {
+    enum class Stage { Rolling, Turn, Defense, Over };
+
+    Board board;
+    Stage stage = Stage::Rolling;
+    int toMove = 1;      // The side on turn; once over, the side that moved last
+    TurnRecord turn;     // This turn so far: coin values are 0 until known
+    TurnRecord lastTurn; // The turn before, in full; coinCall is 0 if there was none
+    int lastMover = 0;
+    int winner = -1;     // Once over: 1, 2, or 0 for a draw
+};
+
+// --- Turn State Machine ---
+// One game from the dice roll for the first move to the farewell. Every
+// step of a turn is a phase: entering it prints what happened, then the
+// game either waits for the player's answer (onInput) or for an animation
+// to finish (onTimer). Nothing here sleeps or reads input itself, so the
+// caller decides how events arrive. AI decisions are split out the same
+// way: while thinking() the caller runs think(), on any thread, and hands
+// the result to onDecision.
+class Game {
+public:
+    enum class Prompt { None, Start, Call, Action, Place, Conquer, Defense, Farewell };
+
+    // ai plays Red Side; nullptr for a game between two humans.
+    Game(Screen& screen, const Board& board, Rng& rng, const Strategy* ai, double animationSpeed);
+
+    // Logs the dice, every turn and the final board into record, which the
+    // caller has begun with the game's seed.
+    void setRecord(GameRecord* log) { record = log; }
+
+    // Shows the value of every action beside the board each turn, the AI's
+    // included, and what the hints make of each AI decision.
+    void setHints(HintEvaluator* evaluator) { hints = evaluator; }
+
+    // Lets a player answer the coin call with "u" to take back their last
+    // turn and the reply to it. Off unless asked for: over the network the
+    // other player would have no say in it.
+    void setUndo(bool allowed) { undoAllowed = allowed; }
+
+    void start();
+    void onInput(const std::string& line);
+    void onTimer(); // The running animation finished or was skipped
+    TurnAction think();
+    void onDecision(const TurnAction& action);
+
+    bool finished() const { return phase == Phase::Finished; }
+    bool thinking() const { return phase == Phase::AiThinking && !timer.running(); }
+    Prompt prompt() const;     // The answer the game is waiting for, if any
+    int promptPlayer() const;  // Who gives it: 1, 2, or 0 for either
+    bool animating() const { return timer.running(); }
+    int animationRemainingMs() const { return timer.remainingMs(); }
+    uint64_t animationNumber() const { return animations; } // Counts animations started
+    GameView view() const;
+
+private:
+    enum class Phase {
+        RollIntro, BlueRolls, RedRolls, RollResult, StartPrompt,
+        TurnStart, CoinCall, CoinResult, ActionChoice, PlaceSquare, ConquerSquare,
+        DefenseStart, DefenseCall, DefenseToss, DefenseResult,
+        AiCoinToss, AiCoinResult, AiThinking, AiConquer, AiPlace,
+        TurnEnd, Farewell, Finished
+    };
+
+    void enter(Phase next);
+    void await(Phase next) { phase = next; }
+    void animate(int milliseconds, Phase next);
+
+    bool readChoice(const std::string& line, int& choice, const char* retry);
+    bool readSquare(const std::string& line, bool isEmptyRequired, int& square);
+    void printAISummary(int color);
+    void printHintVerdict(const TurnAction& action, int color);
+    TurnRecord currentTurn() const;
+    void recordTurn();
+    void takeBack();
+
+    bool aiToMove() const { return ai != nullptr && board.toMove == 2; }
+    char moverSymbol() const { return (board.toMove == 1) ? P1_SYMBOL : P2_SYMBOL; }
+
+    Screen& screen;
+    Board board;
+    Rng& rng;
+    const Strategy* ai;
+    GameRecord* record = nullptr;
+    HintEvaluator* hints = nullptr;
+    bool undoAllowed = false;
+    AnimationTimer timer;
+    uint64_t animations = 0;
+    Phase phase = Phase::RollIntro;
+    Phase afterAnimation = Phase::RollIntro;
+
+    // The turn in progress
+    int p1Roll = 0;
+    int p2Roll = 0;
+    int coinCall = 0;
+    int coinResult = 0;
+    bool powerTurn = false;
+    bool conquering = false;
+    int defenseCall = 0;
+    int defenseToss = 0;
+    int targetSquare = -1;  // Being conquered, or where the AI places
+    int claimedSquare = -1; // The square that changes hands this turn, if any
+
+    // For view()
+    TurnRecord lastTurn;
+    int lastMover = 0;
+    int winner = -1;
+
+    // Every turn played, to take back; emptied when the game starts
+    static const int HISTORY_TURNS = 256;
+    HistoryRing<MoveUndo, HISTORY_TURNS> history;
+};
+
+// Plays game to the end: waits for input or the next animation deadline,
+// whichever comes first. A line typed during an animation skips it; a bare
+// Enter is used up doing so, anything else answers the next prompt.
+// Returns early if input ends while the game is waiting for it.
+void runGame(Game& game, InputSource& input, Screen& screen);
@@ -0,0 +1,650 @@
+#include "GameRecord.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h> // For CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// --- Encoding ---
+// LEB128: seven bits per byte, low bits first. Returns the end of the write.
+uint8_t* putVarint(uint8_t* out, uint64_t value) {
+    while (value >= 0x80) {
+        *out++ = static_cast<uint8_t>(value | 0x80);
+        value >>= 7;
+    }
+    *out++ = static_cast<uint8_t>(value);
+    return out;
+}
+
+bool getVarint(const uint8_t*& p, const uint8_t* end, uint64_t& value) {
+    value = 0;
+    for (int shift = 0; shift < 64 && p < end; shift += 7) {
+        uint8_t byte = *p++;
+        value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return true;
+    }
+    return false;
+}
+
+// Game indexes usually count up by one, so the delta is almost always 0.
+uint64_t zigzag(int64_t value) {
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+int64_t unzigzag(uint64_t value) {
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Flags byte: winner in bits 0-1, a new seed follows if bit 2 is set, and
+// size - MIN_BOARD_SIZE in bits 3-7.
+const uint8_t FLAG_NEW_SEED = 4;
+
+// A turn in one varint: coin call, coin result and conquer in the low three
+// bits, then for a conquer three bits of defense toss (0 = none), then the
+// square plus one. A placement on the classic board fits in one byte.
+uint64_t encodeTurn(const TurnRecord& turn) {
+    uint64_t value = static_cast<uint64_t>((turn.coinCall - 1) | ((turn.coinResult - 1) << 1) | (turn.conquer ? 4 : 0));
+    uint64_t square = static_cast<uint64_t>(turn.square + 1);
+    if (!turn.conquer) return value | (square << 3);
+    uint64_t defense = (turn.defenseCall == 0) ? 0 : 1 + (turn.defenseCall - 1) + 2 * (turn.defenseToss - 1);
+    return value | (defense << 3) | (square << 6);
+}
+
+TurnRecord decodeTurn(uint64_t value) {
+    TurnRecord turn;
+    turn.coinCall = static_cast<uint8_t>((value & 1) + 1);
+    turn.coinResult = static_cast<uint8_t>(((value >> 1) & 1) + 1);
+    turn.conquer = (value & 4) != 0;
+    if (turn.conquer) {
+        uint64_t defense = (value >> 3) & 7;
+        if (defense != 0) {
+            turn.defenseCall = static_cast<uint8_t>((defense - 1) % 2 + 1);
+            turn.defenseToss = static_cast<uint8_t>((defense - 1) / 2 + 1);
+        }
+        turn.square = static_cast<int16_t>(static_cast<int64_t>(value >> 6) - 1);
+    }
+    else {
+        turn.square = static_cast<int16_t>(static_cast<int64_t>(value >> 3) - 1);
+    }
+    return turn;
+}
+
+const char* sideName(int player) {
+    return (player == 1) ? "Blue Side" : "Red Side";
+}
+
+const char* coinName(int coin) {
+    return (coin == 1) ? "Heads" : "Tails";
+}
+
+} // namespace
+
+void GameRecord::begin(uint64_t seed, uint64_t gameIndex, int size, int winLength) {
+    this->seed = seed;
+    this->gameIndex = gameIndex;
+    this->size = static_cast<uint8_t>(size);
+    this->winLength = static_cast<uint8_t>(winLength);
+    blueRoll = redRoll = winner = 0;
+    turns.clear();
+    cells.clear();
+}
+
+// --- Verification ---
+TurnOutcome applyTurn(Board& board, const TurnRecord& turn, int& claimedSquare) {
+    char symbol = (board.toMove == 1) ? P1_SYMBOL : P2_SYMBOL;
+    char opponentSymbol = (board.toMove == 1) ? P2_SYMBOL : P1_SYMBOL;
+    bool onBoard = turn.square >= 0 && turn.square < cellCount(board);
+    claimedSquare = -1;
+    if (turn.conquer && turn.coinCall == turn.coinResult) {
+        if (!onBoard || cellSymbol(board, turn.square) != opponentSymbol) return TurnOutcome::Forfeited;
+        if (turn.defenseCall == turn.defenseToss) return TurnOutcome::Defended;
+        setCell(board, turn.square, symbol);
+        claimedSquare = turn.square;
+        return TurnOutcome::Conquered;
+    }
+    if (turn.conquer || !onBoard || !isEmptySquare(board, turn.square)) return TurnOutcome::Forfeited;
+    setCell(board, turn.square, symbol);
+    claimedSquare = turn.square;
+    return TurnOutcome::Placed;
+}
+
+bool verifyRecord(const GameRecord& game, std::string& problem) {
+    if (!isValidGeometry(game.size, game.winLength)) {
+        problem = "invalid board geometry";
+        return false;
+    }
+    if (game.blueRoll < 1 || game.blueRoll > 6 || game.redRoll < 1 || game.redRoll > 6 || game.blueRoll == game.redRoll) {
+        problem = "the dice do not decide who starts";
+        return false;
+    }
+    Board board(game.size, game.winLength);
+    if (game.cells.size() != static_cast<size_t>(cellCount(board))) {
+        problem = "final board has the wrong number of squares";
+        return false;
+    }
+    board.toMove = (game.blueRoll > game.redRoll) ? 1 : 2;
+
+    bool over = false;
+    int winner = 0;
+    for (size_t t = 0; t < game.turns.size(); ++t) {
+        const TurnRecord& turn = game.turns[t];
+        if (over) {
+            problem = "turn " + std::to_string(t + 1) + " comes after the game ended";
+            return false;
+        }
+        if (turn.coinCall < 1 || turn.coinCall > 2 || turn.coinResult < 1 || turn.coinResult > 2) {
+            problem = "turn " + std::to_string(t + 1) + " has an invalid coin toss";
+            return false;
+        }
+        int player = board.toMove;
+        char symbol = (player == 1) ? P1_SYMBOL : P2_SYMBOL;
+        int claimedSquare = -1;
+        TurnOutcome outcome = applyTurn(board, turn, claimedSquare);
+        bool tossed = turn.defenseCall >= 1 && turn.defenseCall <= 2 && turn.defenseToss >= 1 && turn.defenseToss <= 2;
+        if ((outcome == TurnOutcome::Conquered || outcome == TurnOutcome::Defended) && !tossed) {
+            problem = "turn " + std::to_string(t + 1) + " conquers without a defense toss";
+            return false;
+        }
+
+        if (checkWinAt(board, claimedSquare, symbol)) {
+            over = true;
+            winner = player;
+        }
+        else if (checkDraw(board)) {
+            over = true;
+        }
+        board.toMove = (player == 1) ? 2 : 1;
+    }
+    if (!over) {
+        problem = "the game never ends";
+        return false;
+    }
+    if (winner != game.winner) {
+        problem = "recorded winner differs from the replay";
+        return false;
+    }
+    for (int i = 0; i < cellCount(board); ++i) {
+        char cell = cellSymbol(board, i);
+        uint8_t expected = (cell == P1_SYMBOL) ? 1 : (cell == P2_SYMBOL) ? 2 : 0;
+        if (game.cells[i] != expected) {
+            problem = "final board differs from the replay at square " + std::to_string(i + 1);
+            return false;
+        }
+    }
+    return true;
+}
+
+// --- Writing ---
+bool RecordWriter::open(const std::string& path, std::string& error) {
+    close();
+    std::error_code status;
+    if (std::filesystem::exists(path, status) && std::filesystem::file_size(path, status) > 0) {
+        // Keep what is there; cut off the old index (or a torn block) and append
+        RecordReader existing;
+        if (!existing.open(path, error)) return false;
+        index = existing.blocks();
+        gameCount = existing.games();
+        offset = existing.dataEnd();
+        existing.close();
+        std::filesystem::resize_file(path, offset, status);
+        if (status) {
+            error = "could not truncate '" + path + "': " + status.message();
+            return false;
+        }
+        file = std::fopen(path.c_str(), "ab");
+    }
+    else {
+        index.clear();
+        gameCount = 0;
+        file = std::fopen(path.c_str(), "wb");
+        RecordFileHeader header = { { 'E', 'G', 'G', 'R' }, RECORD_VERSION };
+        if (file != nullptr && std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            std::fclose(file);
+            file = nullptr;
+        }
+        offset = sizeof(header);
+    }
+    if (file == nullptr) {
+        error = "could not open '" + path + "' for writing";
+        return false;
+    }
+    failed = false;
+    return true;
+}
+
+void RecordWriter::writeBlock(const uint8_t* payload, uint32_t bytes, uint32_t games) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr) return;
+    RecordBlockHeader header = { { 'E', 'G', 'B', 'K' }, games, bytes, 0 };
+    failed |= std::fwrite(&header, sizeof(header), 1, file) != 1 || std::fwrite(payload, 1, bytes, file) != bytes;
+    index.push_back({ offset, gameCount, games, bytes });
+    offset += sizeof(header) + bytes;
+    gameCount += games;
+}
+
+bool RecordWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr) return !failed;
+    RecordTrailer trailer = { offset, static_cast<uint32_t>(index.size()), { 'E', 'G', 'I', 'X' } };
+    failed |= (!index.empty() && std::fwrite(index.data(), sizeof(RecordIndexEntry), index.size(), file) != index.size()) ||
+              std::fwrite(&trailer, sizeof(trailer), 1, file) != 1;
+    failed |= std::fclose(file) != 0;
+    file = nullptr;
+    return !failed;
+}
+
+void RecordStream::add(const GameRecord& game) {
+    if (writer == nullptr) return;
+    // Encoded straight into the block with room for the longest possible
+    // game, then the length is put in front of it.
+    const size_t lengthRoom = 5;
+    size_t worst = lengthRoom + 1 + 8 + 10 + 2 + 10 + game.turns.size() * 3 + (game.cells.size() + 3) / 4;
+    if (block.size() < used + worst) block.resize(std::max(block.size() * 2, used + worst));
+    uint8_t* start = block.data() + used + lengthRoom;
+    uint8_t* p = start;
+
+    bool newSeed = !hasPrevious || game.seed != previousSeed;
+    *p++ = static_cast<uint8_t>(game.winner | (newSeed ? FLAG_NEW_SEED : 0) | ((game.size - MIN_BOARD_SIZE) << 3));
+    if (newSeed) {
+        for (int byte = 0; byte < 8; ++byte) *p++ = static_cast<uint8_t>(game.seed >> (8 * byte));
+    }
+    uint64_t expectedIndex = hasPrevious ? previousIndex + 1 : 0;
+    p = putVarint(p, zigzag(static_cast<int64_t>(game.gameIndex - expectedIndex)));
+    *p++ = static_cast<uint8_t>(game.winLength - 3);
+    *p++ = static_cast<uint8_t>((game.blueRoll - 1) | ((game.redRoll - 1) << 3));
+    p = putVarint(p, game.turns.size());
+    for (const TurnRecord& turn : game.turns) p = putVarint(p, encodeTurn(turn));
+    size_t packedBytes = (game.cells.size() + 3) / 4;
+    std::memset(p, 0, packedBytes);
+    for (size_t i = 0; i < game.cells.size(); ++i) p[i / 4] |= static_cast<uint8_t>(game.cells[i] << (2 * (i % 4)));
+    p += packedBytes;
+
+    size_t bodyBytes = static_cast<size_t>(p - start);
+    uint8_t* lengthEnd = putVarint(block.data() + used, bodyBytes);
+    std::memmove(lengthEnd, start, bodyBytes);
+    used = static_cast<size_t>(lengthEnd - block.data()) + bodyBytes;
+    ++games;
+    hasPrevious = true;
+    previousSeed = game.seed;
+    previousIndex = game.gameIndex;
+    if (used >= RECORD_BLOCK_BYTES) flush();
+}
+
+void RecordStream::flush() {
+    if (writer == nullptr || games == 0) return;
+    writer->writeBlock(block.data(), static_cast<uint32_t>(used), games);
+    used = 0;
+    games = 0;
+    hasPrevious = false; // Every block decodes on its own
+}
+
+// --- Reading ---
+bool RecordCursor::read(GameRecord& game) {
+    uint64_t length = 0;
+    if (left == 0 || broken) return false;
+    if (!getVarint(next, end, length) || length > static_cast<uint64_t>(end - next)) {
+        broken = true;
+        return false;
+    }
+    const uint8_t* p = next;
+    const uint8_t* bodyEnd = next + length;
+    next = bodyEnd;
+    --left;
+
+    if (p == bodyEnd) {
+        broken = true;
+        return false;
+    }
+    uint8_t flags = *p++;
+    if (flags & FLAG_NEW_SEED) {
+        if (bodyEnd - p < 8) {
+            broken = true;
+            return false;
+        }
+        previousSeed = 0;
+        for (int byte = 0; byte < 8; ++byte) previousSeed |= static_cast<uint64_t>(*p++) << (8 * byte);
+    }
+    uint64_t delta = 0;
+    if (!getVarint(p, bodyEnd, delta)) {
+        broken = true;
+        return false;
+    }
+    previousIndex = (hasPrevious ? previousIndex + 1 : 0) + static_cast<uint64_t>(unzigzag(delta));
+    hasPrevious = true;
+
+    game.seed = previousSeed;
+    game.gameIndex = previousIndex;
+    game.winner = flags & 3;
+    game.size = static_cast<uint8_t>((flags >> 3) + MIN_BOARD_SIZE);
+    uint64_t turnCount = 0;
+    if (bodyEnd - p < 2) {
+        broken = true;
+        return false;
+    }
+    game.winLength = static_cast<uint8_t>(*p++ + 3);
+    game.blueRoll = static_cast<uint8_t>((*p & 7) + 1);
+    game.redRoll = static_cast<uint8_t>(((*p >> 3) & 7) + 1);
+    ++p;
+    if (!getVarint(p, bodyEnd, turnCount) || turnCount > static_cast<uint64_t>(bodyEnd - p)) {
+        broken = true;
+        return false;
+    }
+    game.turns.resize(static_cast<size_t>(turnCount));
+    for (TurnRecord& turn : game.turns) {
+        uint64_t value = 0;
+        if (!getVarint(p, bodyEnd, value)) {
+            broken = true;
+            return false;
+        }
+        turn = decodeTurn(value);
+    }
+    size_t cells = static_cast<size_t>(game.size) * game.size;
+    if (static_cast<size_t>(bodyEnd - p) != (cells + 3) / 4) {
+        broken = true;
+        return false;
+    }
+    game.cells.resize(cells);
+    for (size_t i = 0; i < cells; ++i) game.cells[i] = (p[i / 4] >> (2 * (i % 4))) & 3;
+    return true;
+}
+
+bool RecordCursor::skip() {
+    uint64_t length = 0;
+    if (left == 0 || broken) return false;
+    if (!getVarint(next, end, length) || length == 0 || length > static_cast<uint64_t>(end - next)) {
+        broken = true;
+        return false;
+    }
+    // Only the seed and game index carry over to the next game
+    const uint8_t* p = next;
+    const uint8_t* bodyEnd = next + length;
+    uint8_t flags = *p++;
+    if ((flags & FLAG_NEW_SEED) && bodyEnd - p >= 8) {
+        previousSeed = 0;
+        for (int byte = 0; byte < 8; ++byte) previousSeed |= static_cast<uint64_t>(*p++) << (8 * byte);
+    }
+    uint64_t delta = 0;
+    if (!getVarint(p, bodyEnd, delta)) {
+        broken = true;
+        return false;
+    }
+    previousIndex = (hasPrevious ? previousIndex + 1 : 0) + static_cast<uint64_t>(unzigzag(delta));
+    hasPrevious = true;
+    next = bodyEnd;
+    --left;
+    return true;
+}
+
+bool RecordReader::open(const std::string& path, std::string& error) {
+    close();
+    error = "could not read '" + path + "'";
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(RecordFileHeader))) {
+        CloseHandle(file);
+        error = "'" + path + "' is not a game record file";
+        return false;
+    }
+    HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // The mapping keeps the file open
+    if (view == nullptr) return false;
+    void* mapped = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    if (mapped == nullptr) {
+        CloseHandle(view);
+        return false;
+    }
+    fileMapping = view;
+    mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(RecordFileHeader)) {
+        ::close(fd);
+        error = "'" + path + "' is not a game record file";
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps the file open
+    if (mapped == MAP_FAILED) return false;
+    madvise(mapped, static_cast<size_t>(info.st_size), MADV_SEQUENTIAL);
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    data = static_cast<const uint8_t*>(mapped);
+
+    RecordFileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, "EGGR", 4) != 0 || header.version != RECORD_VERSION) {
+        close();
+        error = "'" + path + "' is not a game record file";
+        return false;
+    }
+    error.clear();
+
+    // The index, if the last writer closed cleanly
+    RecordTrailer trailer;
+    if (mappedSize >= sizeof(header) + sizeof(trailer)) {
+        std::memcpy(&trailer, data + mappedSize - sizeof(trailer), sizeof(trailer));
+        uint64_t indexBytes = static_cast<uint64_t>(trailer.blockCount) * sizeof(RecordIndexEntry);
+        if (std::memcmp(trailer.magic, "EGIX", 4) == 0 && trailer.indexOffset >= sizeof(header) &&
+            trailer.indexOffset + indexBytes + sizeof(trailer) == mappedSize) {
+            index.resize(trailer.blockCount);
+            if (!index.empty()) std::memcpy(index.data(), data + trailer.indexOffset, static_cast<size_t>(indexBytes));
+            hasIndex = true;
+            for (const RecordIndexEntry& entry : index) {
+                hasIndex &= entry.firstGame == gameCount &&
+                            entry.offset + sizeof(RecordBlockHeader) + entry.bytes <= trailer.indexOffset;
+                gameCount += entry.games;
+            }
+            blocksEnd = trailer.indexOffset;
+            if (!hasIndex) {
+                index.clear();
+                gameCount = 0;
+            }
+        }
+    }
+    // Otherwise walk the block headers up to the first incomplete one
+    if (!hasIndex) {
+        uint64_t offset = sizeof(header);
+        RecordBlockHeader block;
+        while (offset + sizeof(block) <= mappedSize) {
+            std::memcpy(&block, data + offset, sizeof(block));
+            if (std::memcmp(block.magic, "EGBK", 4) != 0 || offset + sizeof(block) + block.bytes > mappedSize) break;
+            index.push_back({ offset, gameCount, block.games, block.bytes });
+            gameCount += block.games;
+            offset += sizeof(block) + block.bytes;
+        }
+        blocksEnd = offset;
+    }
+    return true;
+}
+
+void RecordReader::close() {
+    if (data != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+        CloseHandle(fileMapping);
+        fileMapping = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data), mappedSize);
+#endif
+    }
+    data = nullptr;
+    mappedSize = 0;
+    index.clear();
+    gameCount = 0;
+    blocksEnd = 0;
+    hasIndex = false;
+}
+
+RecordCursor RecordReader::cursor(size_t block) const {
+    const RecordIndexEntry& entry = index[block];
+    return RecordCursor(data + entry.offset + sizeof(RecordBlockHeader), entry.bytes, entry.games);
+}
+
+bool RecordReader::find(uint64_t ordinal, GameRecord& game) const {
+    if (ordinal >= gameCount) return false;
+    auto after = std::upper_bound(index.begin(), index.end(), ordinal,
+                                  [](uint64_t value, const RecordIndexEntry& entry) { return value < entry.firstGame; });
+    size_t block = static_cast<size_t>(after - index.begin()) - 1;
+    RecordCursor games = cursor(block);
+    for (uint64_t skipped = index[block].firstGame; skipped < ordinal; ++skipped) {
+        if (!games.skip()) return false;
+    }
+    return games.read(game);
+}
+
+// --- Command Line ---
+namespace {
+
+void printRecordBoard(const Board& board) {
+    for (int row = 0; row < board.size; ++row) {
+        std::cout << "   ";
+        for (int col = 0; col < board.size; ++col) {
+            char cell = cellSymbol(board, row * board.size + col);
+            std::cout << ' ' << (cell != '\0' ? cell : '.');
+        }
+        std::cout << "\n";
+    }
+}
+
+// Narrates game the way it was played, with the board after every turn.
+void printRecord(const GameRecord& game, uint64_t ordinal, uint64_t total) {
+    std::cout << "Game " << ordinal << " of " << total << ": seed " << game.seed << ", game index " << game.gameIndex << ", "
+              << int(game.size) << "x" << int(game.size) << " with " << int(game.winLength) << " in a row\n";
+    std::cout << "Dice: Blue Side rolled " << int(game.blueRoll) << ", Red Side rolled " << int(game.redRoll) << ".\n\n";
+    Board board(game.size, game.winLength);
+    board.toMove = (game.blueRoll > game.redRoll) ? 1 : 2;
+    for (size_t t = 0; t < game.turns.size(); ++t) {
+        const TurnRecord& turn = game.turns[t];
+        int player = board.toMove;
+        bool power = (turn.coinCall == turn.coinResult);
+        std::cout << "Turn " << t + 1 << ", " << sideName(player) << ": called " << coinName(turn.coinCall)
+                  << ", tossed " << coinName(turn.coinResult) << (power ? ", power turn. " : ". ");
+        int claimedSquare = -1;
+        switch (applyTurn(board, turn, claimedSquare)) {
+        case TurnOutcome::Placed:
+            std::cout << "Places on " << turn.square + 1 << ".\n";
+            break;
+        case TurnOutcome::Conquered:
+        case TurnOutcome::Defended:
+            std::cout << "Tries to conquer " << turn.square + 1 << "; the defender calls " << coinName(turn.defenseCall)
+                      << ", tossed " << coinName(turn.defenseToss) << (claimedSquare >= 0 ? ": conquered!\n" : ": defended.\n");
+            break;
+        case TurnOutcome::Forfeited:
+            if (turn.conquer && power) std::cout << "Tries to conquer " << turn.square + 1 << ", not an opponent's square: forfeited.\n";
+            else std::cout << "Forfeits the turn.\n";
+            break;
+        }
+        printRecordBoard(board);
+        board.toMove = (player == 1) ? 2 : 1;
+    }
+    std::cout << "\n" << (game.winner == 0 ? "Draw" : std::string(sideName(game.winner)) + " wins")
+              << " after " << game.turns.size() << " turns.\n";
+}
+
+} // namespace
+
+int replayCommand(int argc, char* argv[]) {
+    std::string path;
+    bool pickGame = false;
+    uint64_t ordinal = 0;
+    bool verify = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--replay" && hasValue) path = argv[++i];
+        else if (arg == "--game" && hasValue) {
+            pickGame = true;
+            ordinal = std::strtoull(argv[++i], nullptr, 10);
+        }
+        else if (arg == "--verify") verify = true;
+        else {
+            std::cout << "Unknown option '" << arg << "'.\nUsage: EchoGrid --replay FILE [--game N] [--verify]\n";
+            return 1;
+        }
+    }
+    if (path.empty()) {
+        std::cout << "Usage: EchoGrid --replay FILE [--game N] [--verify]\n";
+        return 1;
+    }
+
+    RecordReader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cout << "Could not open game records: " << error << ".\n";
+        return 1;
+    }
+
+    GameRecord game;
+    std::string problem;
+    if (pickGame) {
+        if (!reader.find(ordinal, game)) {
+            std::cout << "No game " << ordinal << " in '" << path << "' (" << reader.games() << " games, numbered from 0).\n";
+            return 1;
+        }
+        printRecord(game, ordinal, reader.games());
+        if (verify) {
+            bool ok = verifyRecord(game, problem);
+            std::cout << (ok ? "Verified: the game follows the rules.\n" : "Verification failed: " + problem + ".\n");
+            return ok ? 0 : 1;
+        }
+        return 0;
+    }
+
+    // Scan everything
+    uint64_t wins[3] = { 0, 0, 0 };
+    uint64_t turns = 0;
+    uint64_t scanned = 0;
+    uint64_t failures = 0;
+    int corruptBlocks = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t b = 0; b < reader.blocks().size(); ++b) {
+        RecordCursor cursor = reader.cursor(b);
+        uint64_t position = reader.blocks()[b].firstGame;
+        while (cursor.read(game)) {
+            ++wins[game.winner % 3];
+            turns += game.turns.size();
+            if (verify && !verifyRecord(game, problem) && ++failures <= 10) {
+                std::cout << "Game " << position << " (seed " << game.seed << ", game index " << game.gameIndex << "): " << problem << ".\n";
+            }
+            ++scanned;
+            ++position;
+        }
+        if (cursor.failed()) {
+            ++corruptBlocks;
+            std::cout << "Block " << b << " is corrupt after game " << position << ".\n";
+        }
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = elapsed.count();
+
+    double bytes = static_cast<double>(reader.fileBytes());
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << path << ": " << reader.games() << " games in " << reader.blocks().size() << " blocks, "
+              << bytes / (1 << 20) << " MB (" << (scanned ? bytes / scanned : 0.0) << " bytes/game)"
+              << (reader.indexed() ? "" : ", no index: blocks found by scanning") << "\n";
+    std::cout << std::setprecision(2) << " Blue Side wins " << (scanned ? 100.0 * wins[1] / scanned : 0.0) << "%, Red Side wins "
+              << (scanned ? 100.0 * wins[2] / scanned : 0.0) << "%, draws " << (scanned ? 100.0 * wins[0] / scanned : 0.0)
+              << "%, " << (scanned ? static_cast<double>(turns) / scanned : 0.0) << " turns per game\n";
+    std::cout << std::setprecision(1) << " " << (verify ? "Verified" : "Scanned") << " in " << std::setprecision(3) << seconds
+              << " s: " << std::setprecision(1) << (seconds > 0 ? bytes / seconds / (1 << 20) : 0.0) << " MB/s, "
+              << (seconds > 0 ? scanned / seconds / 1e6 : 0.0) << " M games/s\n";
+    if (verify) std::cout << " " << failures << " game(s) break the rules\n";
+    return (failures == 0 && corruptBlocks == 0) ? 0 : 1;
+}
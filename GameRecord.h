@@ -0,0 +1,213 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+
+// --- Game Records ---
+// Every finished game can be appended to a compact binary archive and
+// replayed or audited later. A file is a small header, then blocks of
+// games written back to back, then an index of the blocks and a trailer
+// pointing at it:
+//
+//   RecordFileHeader | block | block | ... | RecordIndexEntry[] | RecordTrailer
+//
+// A block is a RecordBlockHeader followed by its games. Inside a block each
+// game is a varint length, then a flags byte (winner, board size, whether a
+// new seed follows), the seed when it changed, the game index as a delta
+// from the previous game's, the win length, both dice, the turn count, one
+// varint per turn and the final board at 2 bits per square. A classic game
+// takes about 18 bytes.
+//
+// The index is only written when a writer closes; if it is missing (the
+// process died mid-run) readers find the blocks by walking their headers,
+// and the next writer rebuilds it.
+
+const uint32_t RECORD_VERSION = 1;
+const size_t RECORD_BLOCK_BYTES = 64 * 1024; // A stream hands over its block once it reaches this size
+
+struct RecordFileHeader {
+    char magic[4]; // "EGGR"
+    uint32_t version;
+};
+
+struct RecordBlockHeader {
+    char magic[4]; // "EGBK"
+    uint32_t games;
+    uint32_t bytes; // Payload after this header
+    uint32_t reserved;
+};
+
+struct RecordIndexEntry {
+    uint64_t offset;    // Of the block header
+    uint64_t firstGame; // Position in the file of the block's first game
+    uint32_t games;
+    uint32_t bytes;
+};
+
+struct RecordTrailer {
+    uint64_t indexOffset;
+    uint32_t blockCount;
+    char magic[4]; // "EGIX"
+};
+
+// One turn as it was played. Coin values are 1 (Heads) or 2 (Tails).
+struct TurnRecord {
+    uint8_t coinCall = 1;
+    uint8_t coinResult = 1;
+    bool conquer = false;    // Tried to conquer on a power turn
+    uint8_t defenseCall = 0; // Both 0 unless there was a defense toss
+    uint8_t defenseToss = 0;
+    int16_t square = -1;     // Placed on or targeted; -1 if the mover had none
+};
+
+// One game: enough to replay it move by move and to check it against the
+// rules. Kept and reused by whoever plays the games, so recording does not
+// allocate once the vectors have grown.
+struct GameRecord {
+    uint64_t seed = 0;
+    uint64_t gameIndex = 0; // Rng(seed, gameIndex) rolled the dice and tossed the coins
+    uint8_t size = CLASSIC_SIZE;
+    uint8_t winLength = CLASSIC_SIZE;
+    uint8_t blueRoll = 0;   // The deciding roll; ties before it are not kept
+    uint8_t redRoll = 0;
+    uint8_t winner = 0;     // 1 = Blue Side, 2 = Red Side, 0 = draw
+    std::vector<TurnRecord> turns;
+    std::vector<uint8_t> cells; // Final board: 0 empty, 1 Blue Side, 2 Red Side
+
+    void begin(uint64_t seed, uint64_t gameIndex, int size, int winLength);
+
+    template <typename BoardType>
+    void finish(const BoardType& board, int winner) {
+        this->winner = static_cast<uint8_t>(winner);
+        cells.resize(cellCount(board));
+        for (int i = 0; i < cellCount(board); ++i) {
+            char cell = cellSymbol(board, i);
+            cells[i] = (cell == P1_SYMBOL) ? 1 : (cell == P2_SYMBOL) ? 2 : 0;
+        }
+    }
+};
+
+// What a recorded turn did when replayed.
+enum class TurnOutcome { Placed, Conquered, Defended, Forfeited };
+
+// Plays turn for board.toMove under the same rules as the game engine,
+// forfeits included, without passing the move to the other side.
+// claimedSquare is the square that changed hands, or -1.
+TurnOutcome applyTurn(Board& board, const TurnRecord& turn, int& claimedSquare);
+
+// Replays game on an empty board under the rules and checks that it ends
+// exactly at its last turn, with its recorded winner and final board.
+// Returns false and says why if anything disagrees.
+bool verifyRecord(const GameRecord& game, std::string& problem);
+
+// --- Writing ---
+// Appends blocks to one file. Any number of RecordStreams may share a
+// writer; only handing over a full block takes its lock.
+class RecordWriter {
+public:
+    RecordWriter() = default;
+    ~RecordWriter() { close(); }
+    RecordWriter(const RecordWriter&) = delete;
+    RecordWriter& operator=(const RecordWriter&) = delete;
+
+    // Creates path, or reopens it to append after the games already there.
+    bool open(const std::string& path, std::string& error);
+    void writeBlock(const uint8_t* payload, uint32_t bytes, uint32_t games);
+    bool close(); // Writes the index; false if anything failed to write
+    uint64_t games() const { return gameCount; }
+
+private:
+    FILE* file = nullptr;
+    std::mutex mutex;
+    std::vector<RecordIndexEntry> index;
+    uint64_t offset = 0;
+    uint64_t gameCount = 0;
+    bool failed = false;
+};
+
+// Encodes games into a block of its own and hands full blocks to a writer.
+// One per thread; a null writer records nothing.
+class RecordStream {
+public:
+    explicit RecordStream(RecordWriter* writer) : writer(writer) {}
+    ~RecordStream() { flush(); }
+    RecordStream(const RecordStream&) = delete;
+    RecordStream& operator=(const RecordStream&) = delete;
+
+    void add(const GameRecord& game);
+    void flush();
+
+private:
+    RecordWriter* writer;
+    std::vector<uint8_t> block; // Only grows; used bytes of it are filled
+    size_t used = 0;
+    uint32_t games = 0;
+    bool hasPrevious = false; // Seeds and game indexes are relative to the previous game
+    uint64_t previousSeed = 0;
+    uint64_t previousIndex = 0;
+};
+
+// --- Reading ---
+// Decodes the games of one block in order.
+class RecordCursor {
+public:
+    RecordCursor(const uint8_t* data, uint32_t bytes, uint32_t games) : next(data), end(data + bytes), left(games) {}
+
+    // False once the block is done or is corrupt (then failed() is true).
+    bool read(GameRecord& game);
+    bool skip(); // Steps over a game without decoding it
+    bool failed() const { return broken; }
+
+private:
+    const uint8_t* next;
+    const uint8_t* end;
+    uint32_t left;
+    bool broken = false;
+    bool hasPrevious = false;
+    uint64_t previousSeed = 0;
+    uint64_t previousIndex = 0;
+};
+
+// Read-only view of a record file, memory-mapped like the policy table so a
+// scan decodes straight out of the page cache.
+class RecordReader {
+public:
+    RecordReader() = default;
+    ~RecordReader() { close(); }
+    RecordReader(const RecordReader&) = delete;
+    RecordReader& operator=(const RecordReader&) = delete;
+
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    uint64_t games() const { return gameCount; }
+    uint64_t fileBytes() const { return mappedSize; }
+    uint64_t dataEnd() const { return blocksEnd; } // Just past the last complete block
+    bool indexed() const { return hasIndex; }      // False if the blocks had to be walked
+    const std::vector<RecordIndexEntry>& blocks() const { return index; }
+
+    RecordCursor cursor(size_t block) const;
+    // The game at position ordinal in the file, found through the index.
+    bool find(uint64_t ordinal, GameRecord& game) const;
+
+private:
+    const uint8_t* data = nullptr;
+    size_t mappedSize = 0;
+#if defined(_WIN32)
+    void* fileMapping = nullptr;
+#endif
+    std::vector<RecordIndexEntry> index;
+    uint64_t gameCount = 0;
+    uint64_t blocksEnd = 0;
+    bool hasIndex = false;
+};
+
+// Entry point for "EchoGrid --replay FILE [--game N] [--verify]": without
+// --game it scans every game and reports the file's contents and the scan
+// rate; --game N prints game N turn by turn; --verify checks each game it
+// reads against the rules.
+int replayCommand(int argc, char* argv[]);
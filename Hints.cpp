@@ -0,0 +1,189 @@
+#include "Hints.h"
+#include <chrono>
+#include <cmath>
+#include "Metrics.h"
+
+namespace {
+
+// How sharply the estimate turns window balance into a chance to win: a
+// lead of one window one short of a line is worth about 80%.
+const float HINT_SCALE = 1.5f;
+
+const int DIRECTIONS[4][2] = { { 0, 1 }, { 1, 0 }, { 1, 1 }, { 1, -1 } };
+
+} // namespace
+
+const MoveHints& HintEvaluator::evaluate(const Board& board, char playerSymbol) {
+    METRICS_SCOPE(Hints);
+    auto start = std::chrono::steady_clock::now();
+    int cells = cellCount(board);
+    hints.mover = playerSymbol;
+    hints.place.assign(cells, HINT_NONE);
+    hints.conquer.assign(cells, HINT_NONE);
+    hints.rescored = 0;
+
+    if (isClassicBoard(board) && policy != nullptr && policy->isLoaded()) {
+        evaluateExact(board, playerSymbol);
+    }
+    else {
+        hints.exact = false;
+        if (board.size != size || board.winLength != winLength) rebuild(board);
+        for (int s = 0; s < cells; ++s) {
+            int owner = board.p1.test(s) ? 1 : board.p2.test(s) ? 2 : 0;
+            if (owner != owners[s]) changeSquare(s, owner);
+        }
+
+        int side = (playerSymbol == P1_SYMBOL) ? 0 : 1;
+        int opponent = 2 - side; // As an owner: the other side's 1 or 2
+        bool lastSquare = (board.filled + 1 == cells);
+        float defended = estimate(Effect(), side); // The board as it is, with the opponent to move
+        for (int s = 0; s < cells; ++s) {
+            if (stale[s]) {
+                for (int mover = 0; mover < 2; ++mover) {
+                    if (owners[s] == 0) placeEffects[mover][s] = effectOf(s, mover, false);
+                    else if (owners[s] != mover + 1) conquerEffects[mover][s] = effectOf(s, mover, true);
+                }
+                stale[s] = 0;
+                ++hints.rescored;
+            }
+            if (owners[s] == 0) {
+                const Effect& effect = placeEffects[side][s];
+                hints.place[s] = (lastSquare && !effect.wins) ? 0.5f : estimate(effect, side);
+            }
+            else if (owners[s] == opponent) {
+                const Effect& effect = conquerEffects[side][s];
+                float taken = (board.filled == cells && !effect.wins) ? 0.5f : estimate(effect, side);
+                hints.conquer[s] = 0.5f * taken + 0.5f * defended;
+            }
+        }
+    }
+
+    hints.bestPlace = hints.bestConquer = -1;
+    for (int s = 0; s < cells; ++s) {
+        if (hints.place[s] != HINT_NONE && (hints.bestPlace < 0 || hints.place[s] > hints.place[hints.bestPlace])) hints.bestPlace = s;
+        if (hints.conquer[s] != HINT_NONE && (hints.bestConquer < 0 || hints.conquer[s] > hints.conquer[hints.bestConquer])) hints.bestConquer = s;
+    }
+    hints.microseconds = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return hints;
+}
+
+// The solved table holds the mover's score after the toss; before it, a
+// power turn and a normal one are equally likely.
+void HintEvaluator::evaluateExact(const Board& board, char playerSymbol) {
+    hints.exact = true;
+    char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+    uint16_t own = classicMarks(board, playerSymbol);
+    uint16_t theirs = classicMarks(board, opponentSymbol);
+    auto beforeToss = [&](uint16_t mover, uint16_t other) {
+        return (policy->lookup(mover, other, false).score + policy->lookup(mover, other, true).score) / (2.0f * 65535.0f);
+    };
+    auto afterMove = [&](uint16_t mine, uint16_t yours, int square) {
+        Board next;
+        next.p1.words[0] = mine;
+        if (checkWinAt(next, square, P1_SYMBOL)) return 1.0f;
+        if ((mine | yours) == 0x1FF) return 0.5f;
+        return 1.0f - beforeToss(yours, mine);
+    };
+    float defended = 1.0f - beforeToss(theirs, own);
+    for (int s = 0; s < POLICY_CELLS; ++s) {
+        uint16_t bit = static_cast<uint16_t>(1u << s);
+        if (!((own | theirs) & bit)) hints.place[s] = afterMove(own | bit, theirs, s);
+        else if (theirs & bit) hints.conquer[s] = 0.5f * afterMove(own | bit, theirs & ~bit, s) + 0.5f * defended;
+    }
+}
+
+// --- Incremental Estimate ---
+void HintEvaluator::rebuild(const Board& board) {
+    size = board.size;
+    winLength = board.winLength;
+    int cells = size * size;
+    windowCells.clear();
+    std::vector<int> perSquare(cells, 0);
+    for (const auto& d : DIRECTIONS) {
+        for (int row = 0; row < size; ++row) {
+            for (int col = 0; col < size; ++col) {
+                int endRow = row + d[0] * (winLength - 1);
+                int endCol = col + d[1] * (winLength - 1);
+                if (endRow >= size || endCol < 0 || endCol >= size) continue;
+                for (int k = 0; k < winLength; ++k) {
+                    int square = (row + d[0] * k) * size + (col + d[1] * k);
+                    windowCells.push_back(static_cast<uint16_t>(square));
+                    ++perSquare[square];
+                }
+            }
+        }
+    }
+    int windows = static_cast<int>(windowCells.size()) / winLength;
+    windowsFirst.assign(cells + 1, 0);
+    for (int s = 0; s < cells; ++s) windowsFirst[s + 1] = windowsFirst[s] + perSquare[s];
+    windowsOf.assign(windowsFirst[cells], 0);
+    std::vector<int> next(windowsFirst.begin(), windowsFirst.end() - 1);
+    for (int w = 0; w < windows; ++w) {
+        for (int k = 0; k < winLength; ++k) windowsOf[next[windowCells[w * winLength + k]]++] = w;
+    }
+
+    weights.assign(winLength + 1, 0.0f);
+    for (int marks = 1; marks <= winLength; ++marks) weights[marks] = std::pow(4.0f, static_cast<float>(marks - (winLength - 1)));
+    owners.assign(cells, 0);
+    for (int side = 0; side < 2; ++side) {
+        counts[side].assign(windows, 0);
+        placeEffects[side].assign(cells, Effect());
+        conquerEffects[side].assign(cells, Effect());
+        potential[side] = 0.0;
+        threats[side] = 0;
+    }
+    stale.assign(cells, 1);
+}
+
+// Moves square to owner (0 empty, 1 or 2), keeping every window's counts,
+// both sides' potential and threats current, and marks every square that
+// shares a window with it for re-scoring.
+void HintEvaluator::changeSquare(int square, int owner) {
+    int previous = owners[square];
+    for (int i = windowsFirst[square]; i < windowsFirst[square + 1]; ++i) {
+        int w = windowsOf[i];
+        for (int side = 0; side < 2; ++side) {
+            int mine = counts[side][w];
+            int theirs = counts[1 - side][w];
+            if (theirs == 0 && mine > 0) potential[side] -= weights[mine];
+            if (theirs == 0 && mine == winLength - 1) --threats[side];
+        }
+        if (previous != 0) --counts[previous - 1][w];
+        if (owner != 0) ++counts[owner - 1][w];
+        for (int side = 0; side < 2; ++side) {
+            int mine = counts[side][w];
+            int theirs = counts[1 - side][w];
+            if (theirs == 0 && mine > 0) potential[side] += weights[mine];
+            if (theirs == 0 && mine == winLength - 1) ++threats[side];
+        }
+        for (int k = 0; k < winLength; ++k) stale[windowCells[w * winLength + k]] = 1;
+    }
+    owners[square] = static_cast<uint8_t>(owner);
+}
+
+// side placing on square, or taking it from the other side if conquer.
+HintEvaluator::Effect HintEvaluator::effectOf(int square, int side, bool conquer) const {
+    Effect effect;
+    for (int i = windowsFirst[square]; i < windowsFirst[square + 1]; ++i) {
+        int w = windowsOf[i];
+        int mine = counts[side][w];
+        int theirs = counts[1 - side][w];
+        int mineAfter = mine + 1;
+        int theirsAfter = conquer ? theirs - 1 : theirs;
+        float before = ((theirs == 0 && mine > 0) ? weights[mine] : 0.0f) - ((mine == 0 && theirs > 0) ? weights[theirs] : 0.0f);
+        float after = ((theirsAfter == 0) ? weights[mineAfter] : 0.0f); // mineAfter > 0, so theirs count for nothing
+        effect.balance += after - before;
+        if (mineAfter == winLength && theirsAfter == 0) effect.wins = true;
+        if (mine == 0 && theirs == winLength - 1) ++effect.blocked;
+    }
+    return effect;
+}
+
+// The mover's chance after effect, with the opponent to move. An opponent
+// window one short of a line that survives is completed on their turn.
+float HintEvaluator::estimate(const Effect& effect, int side) const {
+    if (effect.wins) return 1.0f;
+    if (threats[1 - side] - effect.blocked > 0) return 0.0f;
+    double balance = potential[side] - potential[1 - side] + effect.balance;
+    return static_cast<float>(1.0 / (1.0 + std::exp(-HINT_SCALE * balance)));
+}
@@ -0,0 +1,74 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "Board.h"
+#include "Policy.h"
+
+// --- Move Hints ---
+// The value of every action open to the side to move, for the hint overlay
+// and for watching what the AI weighs up. A value is the mover's chance to
+// win, counting a draw as half: for placing on an empty square, and for
+// trying to conquer an opponent's square on a power turn (the defense toss
+// saves it half the time, and then the turn is spent).
+//
+// On the classic board with the policy table loaded the values are exact.
+// Elsewhere they are estimates from the lines still open through each
+// square: every window of K squares holding marks of one side only counts
+// for that side, four times more for each extra mark. The evaluator keeps
+// the mark counts of every window as squares change hands and re-scores
+// only the squares sharing a window with a changed one, so a redraw after
+// a move touches a few dozen windows, not the whole board.
+
+const float HINT_NONE = -1.0f; // Not an action the mover has
+
+struct MoveHints {
+    char mover = P1_SYMBOL;
+    bool exact = false;         // From the solved table
+    std::vector<float> place;   // Per square; HINT_NONE unless empty
+    std::vector<float> conquer; // Per square; HINT_NONE unless the opponent's
+    int bestPlace = -1;
+    int bestConquer = -1;
+    int rescored = 0;           // Squares re-scored for this evaluation
+    double microseconds = 0.0;  // What it took
+};
+
+class HintEvaluator {
+public:
+    // policy may be null or not loaded; it is only used on the classic board.
+    explicit HintEvaluator(const PolicyTable* policy = nullptr) : policy(policy) {}
+
+    // Hints for playerSymbol to move on board. Stays valid until the next call.
+    const MoveHints& evaluate(const Board& board, char playerSymbol);
+
+private:
+    // What one action does to the windows through its square, for one mover.
+    struct Effect {
+        float balance = 0.0f; // Change in (mover's windows - opponent's)
+        bool wins = false;    // Completes a line
+        int blocked = 0;      // Opponent windows one short of a line that it breaks
+    };
+
+    void evaluateExact(const Board& board, char playerSymbol);
+    void rebuild(const Board& board);
+    void changeSquare(int square, int owner);
+    Effect effectOf(int square, int side, bool conquer) const;
+    float estimate(const Effect& effect, int side) const;
+
+    const PolicyTable* policy;
+    MoveHints hints;
+
+    // --- Incremental state for the estimate ---
+    int size = 0;
+    int winLength = 0;
+    std::vector<uint8_t> owners;        // 0 empty, 1 Blue Side, 2 Red Side
+    std::vector<uint16_t> windowCells;  // winLength squares per window
+    std::vector<int> windowsFirst;      // windowsOf[windowsFirst[s]..windowsFirst[s + 1]) pass through s
+    std::vector<int> windowsOf;
+    std::vector<uint8_t> counts[2];     // Marks per window, per side
+    std::vector<float> weights;         // By marks in an otherwise empty window
+    double potential[2] = { 0.0, 0.0 };
+    int threats[2] = { 0, 0 };          // Windows one mark short of a line
+    std::vector<Effect> placeEffects[2];   // Cached per square, per mover
+    std::vector<Effect> conquerEffects[2];
+    std::vector<uint8_t> stale;         // Squares whose cached effects need re-scoring
+};
@@ -0,0 +1,111 @@
+#include "Input.h"
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <thread>
+
+struct LineInput::Shared {
+    mutable std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::string> lines;
+    uint64_t taken = 0;
+    uint64_t received = 0;
+    bool closed = false;
+};
+
+LineInput::LineInput() : shared(std::make_shared<Shared>()) {
+    // The reader may sit in getline until the process exits, so it is
+    // detached and keeps its own reference to the queue.
+    std::shared_ptr<Shared> queue = shared;
+    std::thread([queue]() {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            if (!line.empty() && line.back() == '\r') line.pop_back();
+            std::lock_guard<std::mutex> lock(queue->mutex);
+            queue->lines.push_back(line);
+            ++queue->received;
+            queue->ready.notify_all();
+        }
+        std::lock_guard<std::mutex> lock(queue->mutex);
+        queue->closed = true;
+        queue->ready.notify_all();
+    }).detach();
+}
+
+bool LineInput::waitForLine(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(shared->mutex);
+    if (timeoutMs < 0) {
+        shared->ready.wait(lock, [&]() { return !shared->lines.empty() || shared->closed; });
+    }
+    else {
+        shared->ready.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() { return !shared->lines.empty(); });
+    }
+    return !shared->lines.empty();
+}
+
+const std::string& LineInput::peekLine() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->lines.front(); // Only the caller removes lines, so this stays valid
+}
+
+std::string LineInput::takeLine() {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    std::string line = std::move(shared->lines.front());
+    shared->lines.pop_front();
+    ++shared->taken;
+    return line;
+}
+
+uint64_t LineInput::linesReceived() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->received;
+}
+
+uint64_t LineInput::nextLineNumber() const {
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    return shared->taken;
+}
+
+bool parseNumber(const std::string& line, int& value) {
+    const char* text = line.c_str();
+    char* end = nullptr;
+    errno = 0;
+    long number = std::strtol(text, &end, 10);
+    if (end == text || errno == ERANGE || number < INT_MIN || number > INT_MAX) return false;
+    while (*end == ' ' || *end == '\t') ++end;
+    if (*end != '\0') return false;
+    value = static_cast<int>(number);
+    return true;
+}
+
+bool parseNumber(const std::string& line, uint64_t& value) {
+    const char* text = line.c_str();
+    while (*text == ' ' || *text == '\t') ++text;
+    if (*text == '-') return false; // strtoull would wrap it
+    char* end = nullptr;
+    errno = 0;
+    unsigned long long number = std::strtoull(text, &end, 10);
+    if (end == text || errno == ERANGE) return false;
+    while (*end == ' ' || *end == '\t') ++end;
+    if (*end != '\0') return false;
+    value = static_cast<uint64_t>(number);
+    return true;
+}
+
+bool parseNumber(const std::string& line, double& value) {
+    const char* text = line.c_str();
+    char* end = nullptr;
+    errno = 0;
+    double number = std::strtod(text, &end);
+    if (end == text || errno == ERANGE || !std::isfinite(number)) return false;
+    while (*end == ' ' || *end == '\t') ++end;
+    if (*end != '\0') return false;
+    value = number;
+    return true;
+}
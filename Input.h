@@ -0,0 +1,71 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// --- Input Source ---
+// Where the answers to the game's prompts come from, one line at a time.
+class InputSource {
+public:
+    virtual ~InputSource() = default;
+
+    // Waits up to timeoutMs for a line to be queued; a negative timeout waits
+    // until one arrives or input ends. Returns whether a line is queued.
+    virtual bool waitForLine(int timeoutMs) = 0;
+    virtual const std::string& peekLine() const = 0; // Requires a queued line
+    virtual std::string takeLine() = 0;              // Requires a queued line
+    // Drops the queued line unanswered, e.g. an Enter that only skipped an animation.
+    virtual void discardLine() { takeLine(); }
+
+    // Lines are numbered in arrival order from 0.
+    virtual uint64_t linesReceived() const = 0;
+    virtual uint64_t nextLineNumber() const = 0; // Of the line takeLine would return
+};
+
+// --- Line Input ---
+// Reads standard input on a background thread, so the game loop never
+// blocks on it: lines are queued as they arrive and the loop waits for
+// either a line or its next timer, whichever comes first.
+class LineInput : public InputSource {
+public:
+    LineInput();
+
+    bool waitForLine(int timeoutMs) override;
+    const std::string& peekLine() const override;
+    std::string takeLine() override;
+    uint64_t linesReceived() const override;
+    uint64_t nextLineNumber() const override;
+
+private:
+    struct Shared;
+    std::shared_ptr<Shared> shared; // Also owned by the reader thread
+};
+
+// --- Script Input ---
+// Lines fixed in advance, e.g. from a session script. They all count as
+// received from the start and nothing ever waits, so an animation ends the
+// moment the game loop looks at it and a script plays out at full speed.
+class ScriptInput : public InputSource {
+public:
+    explicit ScriptInput(std::vector<std::string> lines) : lines(std::move(lines)) {}
+
+    bool waitForLine(int) override { return next < lines.size(); }
+    const std::string& peekLine() const override { return lines[next]; }
+    std::string takeLine() override { return lines[next++]; }
+    uint64_t linesReceived() const override { return lines.size(); }
+    uint64_t nextLineNumber() const override { return next; }
+
+private:
+    std::vector<std::string> lines;
+    size_t next = 0;
+};
+
+// True if line holds a single whole number that fits in an int (surrounding
+// blanks allowed).
+bool parseNumber(const std::string& line, int& value);
+// The same for a count or seed that is never negative, and for a number
+// that may have a fraction, as command line options take them.
+bool parseNumber(const std::string& line, uint64_t& value);
+bool parseNumber(const std::string& line, double& value);
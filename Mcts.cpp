@@ -0,0 +1,385 @@
+#include "Mcts.h"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
+#include "Move.h"
+
+namespace {
+
+const int32_t UNEXPANDED = -1;
+const int32_t EXPANDING = -2;  // Another thread is creating the children
+const int32_t LEAF = -3;       // The pool was full; this node stays a leaf
+const uint64_t WIN_POINTS = 2; // Scores are kept in half points
+const int TIME_CHECK_INTERVAL = 32;
+const uint32_t TABLE_PROBE_LIMIT = 64; // Past this many visits a child trusts its own statistics
+
+struct Node {
+    std::atomic<uint32_t> visits;     // Includes descents still in flight
+    std::atomic<int32_t> firstChild;  // Index of the first child, or one of the states above
+    std::atomic<uint64_t> score;      // Half points for the player who chose this action
+    uint64_t afterKey;                // Place actions: table key of the position it leads to, else 0
+    uint16_t childCount;
+    int16_t square;                   // Action nodes only
+    bool conquer;
+};
+
+// Fixed-capacity node pool shared by all search threads. Nodes are never
+// freed during a search; reset() empties the pool for the next one and only
+// allocates when that one wants more nodes than the pool has ever held.
+class NodePool {
+public:
+    void reset(int newCapacity) {
+        if (newCapacity > allocated) {
+            nodes.reset(new Node[newCapacity]);
+            allocated = newCapacity;
+        }
+        capacity = newCapacity;
+        used.store(0, std::memory_order_relaxed);
+    }
+
+    Node& operator[](int32_t index) { return nodes[index]; }
+
+    // Reserves count fresh nodes and returns the first, or -1 if the pool is full.
+    int32_t allocate(int count) {
+        int32_t first = used.fetch_add(count, std::memory_order_relaxed);
+        if (first + count > capacity) return -1;
+        for (int32_t i = first; i < first + count; ++i) {
+            Node& node = nodes[i];
+            node.visits.store(0, std::memory_order_relaxed);
+            node.firstChild.store(UNEXPANDED, std::memory_order_relaxed);
+            node.score.store(0, std::memory_order_relaxed);
+            node.childCount = 0;
+            node.afterKey = 0;
+            node.square = -1;
+            node.conquer = false;
+        }
+        return first;
+    }
+
+    int size() const {
+        int32_t count = used.load(std::memory_order_relaxed);
+        return count < capacity ? count : capacity;
+    }
+
+private:
+    std::unique_ptr<Node[]> nodes;
+    int allocated = 0;
+    int capacity = 0;
+    std::atomic<int32_t> used{ 0 };
+};
+
+// Claims node for expansion and reserves count children for it. Returns the
+// first child, or -1 if another thread is already expanding it or the pool
+// is full. The caller fills the children in and then calls publishChildren.
+int32_t claimChildren(NodePool& pool, Node& node, int count) {
+    int32_t state = UNEXPANDED;
+    if (!node.firstChild.compare_exchange_strong(state, EXPANDING, std::memory_order_acquire)) return -1;
+    int32_t first = pool.allocate(count);
+    if (first < 0) node.firstChild.store(LEAF, std::memory_order_release);
+    return first;
+}
+
+void publishChildren(Node& node, int32_t first, int count) {
+    node.childCount = static_cast<uint16_t>(count);
+    node.firstChild.store(first, std::memory_order_release);
+}
+
+enum class Expansion { Ready, Fresh, Leaf };
+
+// Everything a search thread shares with the others, plus its own counters
+// (on their own cache line).
+struct alignas(64) SearchContext {
+    NodePool& pool;
+    TranspositionTable* table; // Null when the table is turned off
+    TableCounters counters;
+    double exploration;
+    int turnLimit;
+};
+
+// The action nodes one descent went through, with who chose each.
+using SearchPath = std::vector<std::pair<int32_t, char>>;
+
+// Gives a decision node one action child per legal place and, on a power
+// turn, per conquerable square. hash is the current position's, used to key
+// each place by the position it leads to.
+template <typename BoardType>
+Expansion expandDecision(SearchContext& context, Node& node, const BoardType& board, char mover, bool powerTurn, const SymmetricHash& hash) {
+    NodePool& pool = context.pool;
+    if (node.firstChild.load(std::memory_order_acquire) >= 0) return Expansion::Ready;
+    char opponent = (mover == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+    MoveList places;
+    MoveList conquests;
+    generatePlacements(board, places);
+    if (powerTurn) generateConquests(board, mover, conquests);
+    int count = places.count + conquests.count;
+    int32_t first = (count > 0) ? claimChildren(pool, node, count) : -1;
+    if (first < 0) return Expansion::Leaf;
+    for (int k = 0; k < places.count; ++k) {
+        Node& child = pool[first + k];
+        child.square = places.squares[k];
+        if (context.table) {
+            SymmetricHash after = hash;
+            toggleSquare(after, board, places[k], mover);
+            child.afterKey = canonicalKey(after, opponent);
+        }
+    }
+    for (int k = 0; k < conquests.count; ++k) {
+        Node& child = pool[first + places.count + k];
+        child.square = conquests.squares[k];
+        child.conquer = true;
+    }
+    publishChildren(node, first, count);
+    return Expansion::Fresh;
+}
+
+// Chance children of an action node, indexed by outcome: bit 0 is the next
+// player's power-turn toss, bit 1 a successful conquer.
+int32_t outcomeChildren(NodePool& pool, Node& action) {
+    int32_t first = action.firstChild.load(std::memory_order_acquire);
+    if (first >= 0) return first;
+    int count = action.conquer ? 4 : 2;
+    first = claimChildren(pool, action, count);
+    if (first >= 0) publishChildren(action, first, count);
+    return first;
+}
+
+// UCT over the action children. A lightly visited child borrows the table's
+// statistics when the table knows its position better; a child that neither
+// has seen is taken at once.
+int32_t selectAction(SearchContext& context, const Node& parent) {
+    NodePool& pool = context.pool;
+    int32_t first = parent.firstChild.load(std::memory_order_acquire);
+    double logVisits = std::log(static_cast<double>(parent.visits.load(std::memory_order_relaxed)) + 1.0);
+    int32_t best = first;
+    double bestValue = -1.0;
+    for (int32_t child = first; child < first + parent.childCount; ++child) {
+        uint64_t visits = pool[child].visits.load(std::memory_order_relaxed);
+        uint64_t score = pool[child].score.load(std::memory_order_relaxed);
+        TableStats known;
+        if (context.table && visits < TABLE_PROBE_LIMIT && pool[child].afterKey != 0 &&
+            context.table->probe(pool[child].afterKey, known, context.counters) && known.visits > visits) {
+            visits = known.visits;
+            score = known.score;
+        }
+        if (visits == 0) return child;
+        double mean = static_cast<double>(score) / (WIN_POINTS * visits);
+        double value = mean + context.exploration * std::sqrt(logVisits / visits);
+        if (value > bestValue) {
+            bestValue = value;
+            best = child;
+        }
+    }
+    return best;
+}
+
+// Finishes the game with cheap random play that still takes any immediate
+// win. Returns the winner's symbol, or '\0' for a draw.
+template <typename BoardType>
+char playout(BoardType& board, char mover, bool powerTurn, int turnsLeft, Rng& rng) {
+    int empty[MAX_CELLS];
+    int opponentSquares[MAX_CELLS];
+    for (; turnsLeft > 0; --turnsLeft) {
+        char opponent = (mover == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+        int claimed = findCompletingSquare(board, mover);
+        if (claimed == -1) {
+            int emptyCount = 0;
+            int opponentCount = 0;
+            for (int i = 0; i < cellCount(board); ++i) {
+                char cell = cellSymbol(board, i);
+                if (cell == '\0') empty[emptyCount++] = i;
+                else if (cell == opponent) opponentSquares[opponentCount++] = i;
+            }
+            if (powerTurn && opponentCount > 0 && rng.below(4) == 0) {
+                if (rng.below(2) == 0) claimed = opponentSquares[rng.below(opponentCount)]; // Defense toss lost
+            }
+            else {
+                claimed = empty[rng.below(emptyCount)];
+            }
+        }
+        if (claimed != -1) {
+            setCell(board, claimed, mover);
+            if (checkWinAt(board, claimed, mover)) return mover;
+        }
+        if (checkDraw(board)) return '\0';
+        mover = opponent;
+        powerTurn = rng.below(2) == 0;
+    }
+    return '\0'; // Conquer cycles can go on for a long time; call it a draw
+}
+
+// One descent from the root, one expansion, one playout and the backup.
+template <typename BoardType>
+void runIteration(SearchContext& context, const BoardType& rootBoard, const SymmetricHash& rootHash, char rootMover, bool rootPower,
+                  Rng& rng, SearchPath& path) {
+    NodePool& pool = context.pool;
+    int turnLimit = context.turnLimit;
+    BoardType board = rootBoard;
+    SymmetricHash hash = rootHash;
+    char mover = rootMover;
+    bool powerTurn = rootPower;
+    int32_t decision = 0;
+    int depth = 0;
+    bool finished = false;
+    char winner = '\0';
+    path.clear();
+
+    while (depth < turnLimit) {
+        Node& node = pool[decision];
+        node.visits.fetch_add(1, std::memory_order_relaxed);
+        Expansion expansion = expandDecision(context, node, board, mover, powerTurn, hash);
+        if (expansion == Expansion::Leaf) break;
+
+        int32_t actionIndex = selectAction(context, node);
+        Node& action = pool[actionIndex];
+        action.visits.fetch_add(1, std::memory_order_relaxed); // Virtual loss until the score arrives
+        path.emplace_back(actionIndex, mover);
+
+        bool conquered = false;
+        int claimed = action.square;
+        if (action.conquer) {
+            conquered = rng.below(2) == 0; // The defender loses the toss half the time
+            if (!conquered) claimed = -1;
+        }
+        if (claimed != -1) {
+            if (context.table) {
+                if (conquered) toggleSquare(hash, board, claimed, cellSymbol(board, claimed));
+                toggleSquare(hash, board, claimed, mover);
+            }
+            setCell(board, claimed, mover);
+            if (checkWinAt(board, claimed, mover)) {
+                winner = mover;
+                finished = true;
+                break;
+            }
+        }
+        if (checkDraw(board)) {
+            finished = true;
+            break;
+        }
+        mover = (mover == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+        powerTurn = rng.below(2) == 0;
+        ++depth;
+        if (expansion == Expansion::Fresh) break; // One new node per iteration
+
+        int32_t outcomes = outcomeChildren(pool, action);
+        if (outcomes < 0) break;
+        decision = outcomes + (conquered ? 2 : 0) + (powerTurn ? 1 : 0);
+    }
+
+    if (!finished) {
+        winner = playout(board, mover, powerTurn, turnLimit - depth, rng);
+    }
+    for (const auto& step : path) {
+        uint64_t points = (winner == step.second) ? WIN_POINTS : (winner == '\0' ? 1 : 0);
+        Node& action = pool[step.first];
+        action.score.fetch_add(points, std::memory_order_relaxed);
+        if (context.table && action.afterKey != 0) {
+            context.table->add(action.afterKey, static_cast<uint32_t>(points), context.counters);
+        }
+    }
+}
+
+// Everything a search needs beyond the stack, kept by each thread that
+// searches and handed from one search to the next. Once it has grown to the
+// options in use, a one-thread search makes no heap allocations.
+struct SearchArena {
+    NodePool pool;
+    std::unique_ptr<TranspositionTable> table;
+    std::vector<SearchContext> contexts;
+    std::vector<SearchPath> paths; // One per search thread
+};
+
+SearchArena& searchArena() {
+    thread_local SearchArena arena;
+    return arena;
+}
+
+} // namespace
+
+template <typename BoardType>
+TurnAction searchMcts(const BoardType& board, char playerSymbol, bool powerTurn, const MctsOptions& options, Rng& rng, MctsReport* report) {
+    auto start = std::chrono::steady_clock::now();
+    int thinkMs = (options.thinkMs > 0 || options.maxPlayouts > 0) ? options.thinkMs : MctsOptions().thinkMs;
+    auto deadline = start + std::chrono::milliseconds(thinkMs);
+    int threads = options.threads > 0 ? options.threads : 1;
+    int turnLimit = 4 * cellCount(board);
+
+    SearchArena& arena = searchArena();
+    NodePool& pool = arena.pool;
+    pool.reset(options.maxNodes > 1 ? options.maxNodes : 2);
+    TranspositionTable* table = nullptr;
+    if (options.tableBytes > 0) {
+        if (arena.table) arena.table->reset(options.tableBytes);
+        else arena.table.reset(new TranspositionTable(options.tableBytes));
+        table = arena.table.get();
+    }
+    SymmetricHash rootHash;
+    if (table) rootHash = hashBoard(board);
+    std::vector<SearchContext>& contexts = arena.contexts;
+    contexts.clear();
+    for (int t = 0; t < threads; ++t) contexts.push_back(SearchContext{ pool, table, TableCounters(), options.exploration, turnLimit });
+    if (static_cast<int>(arena.paths.size()) < threads) arena.paths.resize(threads);
+
+    pool.allocate(1);
+    expandDecision(contexts[0], pool[0], board, playerSymbol, powerTurn, rootHash);
+    Node& root = pool[0];
+    int32_t first = root.firstChild.load(std::memory_order_relaxed);
+    uint64_t seedBase = rng.next();
+
+    std::atomic<uint64_t> started{ 0 };
+    std::atomic<uint64_t> completed{ 0 };
+    auto work = [&](int thread) {
+        Rng local(seedBase, static_cast<uint64_t>(thread));
+        SearchPath& path = arena.paths[thread];
+        path.reserve(turnLimit);
+        uint64_t count = 0;
+        while (true) {
+            if (options.maxPlayouts > 0 && started.fetch_add(1, std::memory_order_relaxed) >= options.maxPlayouts) break;
+            if (thinkMs > 0 && count % TIME_CHECK_INTERVAL == 0 && std::chrono::steady_clock::now() >= deadline) break;
+            runIteration(contexts[thread], board, rootHash, playerSymbol, powerTurn, local, path);
+            ++count;
+        }
+        completed.fetch_add(count, std::memory_order_relaxed);
+    };
+
+    // Nothing to think about with fewer than two choices
+    if (first >= 0 && root.childCount > 1) {
+        std::vector<std::thread> helpers;
+        for (int t = 1; t < threads; ++t) helpers.emplace_back(work, t);
+        work(0);
+        for (std::thread& helper : helpers) helper.join();
+    }
+
+    TurnAction action;
+    int32_t best = -1;
+    if (first >= 0) {
+        best = first;
+        for (int32_t child = first; child < first + root.childCount; ++child) {
+            if (pool[child].visits.load(std::memory_order_relaxed) > pool[best].visits.load(std::memory_order_relaxed)) best = child;
+        }
+        action.conquer = pool[best].conquer;
+        action.square = pool[best].square;
+    }
+    if (report) {
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        report->playouts = completed.load();
+        report->seconds = elapsed.count();
+        report->nodes = pool.size();
+        uint32_t visits = (best >= 0) ? pool[best].visits.load() : 0;
+        report->expectedScore = visits ? static_cast<double>(pool[best].score.load()) / (WIN_POINTS * visits) : 0.0;
+        report->tableEntries = table ? table->entryCount() : 0;
+        report->table = TableCounters();
+        for (const SearchContext& context : contexts) report->table.merge(context.counters);
+    }
+    return action;
+}
+
+// --- Instantiations ---
+template TurnAction searchMcts<Board>(const Board&, char, bool, const MctsOptions&, Rng&, MctsReport*);
+template TurnAction searchMcts<Board3x3>(const Board3x3&, char, bool, const MctsOptions&, Rng&, MctsReport*);
+template TurnAction searchMcts<Board4x4>(const Board4x4&, char, bool, const MctsOptions&, Rng&, MctsReport*);
+template TurnAction searchMcts<Board15x15>(const Board15x15&, char, bool, const MctsOptions&, Rng&, MctsReport*);
@@ -0,0 +1,49 @@
+#pragma once
+#include <cstdint>
+#include "AI.h"
+#include "TranspositionTable.h"
+
+// --- Monte Carlo Tree Search ---
+// A search player for boards the solver does not cover. The tree alternates
+// decision nodes (the mover knows whether this is a power turn) with action
+// nodes (place on a square or conquer one). The coin toss for the next turn
+// and the defense toss after a conquer are chance events: each action node
+// keeps one child per outcome and every descent samples which one to follow,
+// so action values are averages over the dice as well as the replies.
+//
+// Searches are tree-parallel. All threads share one node pool, statistics
+// are plain atomics (no locks), and a thread counts its visit on the way
+// down, before the result is known, so a line another thread is exploring
+// looks like a loss until it reports back (virtual loss).
+//
+// Place actions also record their result in a transposition table, keyed by
+// the position they lead to, canonicalized under symmetry. Selection reads
+// it for children the tree has seen less often than the table has, so
+// symmetric and transposed lines share what any of them has learned.
+// Conquer actions, whose result depends on the defense toss, use the tree
+// statistics alone.
+
+struct MctsOptions {
+    int threads = 1;             // Search threads per move
+    int thinkMs = 50;            // Wall-clock budget per move; 0 = no time limit
+    uint64_t maxPlayouts = 0;    // Playout budget per move; 0 = no playout limit
+    int maxNodes = 1 << 20;      // Tree size cap; once full the search keeps playing out from leaves
+    double exploration = 0.7;    // UCT constant, for scores in [0, 1]
+    size_t tableBytes = 1 << 20; // Transposition table per search; 0 turns it off
+};
+
+struct MctsReport {
+    uint64_t playouts = 0;
+    double seconds = 0.0;
+    int nodes = 0;
+    double expectedScore = 0.0; // Of the chosen action, for the mover (draw = 1/2)
+    size_t tableEntries = 0;
+    TableCounters table;
+};
+
+// Picks an action for playerSymbol. Runs until thinkMs or maxPlayouts is
+// reached (at least one of them must be set). With one thread and only a
+// playout budget the result is fully determined by rng. Mcts.cpp
+// instantiates it for Board and every FixedBoard specialization.
+template <typename BoardType>
+TurnAction searchMcts(const BoardType& board, char playerSymbol, bool powerTurn, const MctsOptions& options, Rng& rng, MctsReport* report = nullptr);
@@ -0,0 +1,459 @@
+#include "Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <vector>
+#if defined(_MSC_VER)
+#include <intrin.h> // For _BitScanReverse
+#endif
+
+namespace {
+
+const char* PHASE_NAMES[] = { "inputWait", "boardDraw", "present", "aiThink", "ruleCheck", "game", "serverPump", "hints" };
+const char* COUNTER_NAMES[] = { "games", "moves", "conquerAttempts", "conquerSuccesses", "defenseSaves", "forfeits", "allocations" };
+
+} // namespace
+
+const char* metricName(MetricPhase phase) {
+    return PHASE_NAMES[static_cast<int>(phase)];
+}
+
+const char* metricName(MetricCounter counter) {
+    return COUNTER_NAMES[static_cast<int>(counter)];
+}
+
+bool saveMetrics(const std::string& metricsPath, const std::string& tracePath, std::string& error) {
+    if (!metricsPath.empty() && !writeMetrics(metricsPath, error)) return false;
+    return tracePath.empty() || writeTrace(tracePath, error);
+}
+
+#if ECHOGRID_METRICS
+
+std::atomic<bool> metricsRecording{ false };
+
+namespace {
+
+const int PHASE_COUNT = static_cast<int>(MetricPhase::Count);
+const int COUNTER_COUNT = static_cast<int>(MetricCounter::Count);
+const size_t TRACE_EVENTS_PER_THREAD = 1 << 22; // About 100 MB in all; later events are dropped
+
+// Log-linear buckets in the manner of HdrHistogram: below 64 ticks every
+// value has its own bucket, above that every power of two is split into 32,
+// so a recorded value is known to within about 3%.
+const int HISTOGRAM_SUB_BITS = 5;
+const int HISTOGRAM_SUB = 1 << HISTOGRAM_SUB_BITS;
+const int HISTOGRAM_BUCKETS = 2 * HISTOGRAM_SUB + (63 - HISTOGRAM_SUB_BITS) * HISTOGRAM_SUB;
+
+int highestBit(uint64_t value) {
+#if defined(_MSC_VER)
+    unsigned long index; // Two 32-bit scans so Win32 builds work too
+    if (_BitScanReverse(&index, static_cast<unsigned long>(value >> 32))) return static_cast<int>(index) + 32;
+    _BitScanReverse(&index, static_cast<unsigned long>(value));
+    return static_cast<int>(index);
+#else
+    return 63 - __builtin_clzll(value);
+#endif
+}
+
+int bucketOf(uint64_t ticks) {
+    if (ticks < 2 * HISTOGRAM_SUB) return static_cast<int>(ticks);
+    int top = highestBit(ticks);
+    int shift = top - HISTOGRAM_SUB_BITS;
+    return 2 * HISTOGRAM_SUB + (shift - 1) * HISTOGRAM_SUB + static_cast<int>((ticks >> shift) - HISTOGRAM_SUB);
+}
+
+// The middle of the values that land in bucket.
+double bucketValue(int bucket) {
+    if (bucket < 2 * HISTOGRAM_SUB) return bucket;
+    int shift = (bucket - 2 * HISTOGRAM_SUB) / HISTOGRAM_SUB + 1;
+    uint64_t low = static_cast<uint64_t>(HISTOGRAM_SUB + (bucket - 2 * HISTOGRAM_SUB) % HISTOGRAM_SUB) << shift;
+    return static_cast<double>(low) + static_cast<double>((uint64_t(1) << shift) - 1) / 2.0;
+}
+
+// Every slot has a single writer, its own thread, so a relaxed load and
+// store is enough: no locked instructions, yet safe to read from a reporter.
+inline void bump(std::atomic<uint64_t>& slot, uint64_t amount) {
+    slot.store(slot.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+inline uint64_t read(const std::atomic<uint64_t>& slot) {
+    return slot.load(std::memory_order_relaxed);
+}
+
+struct Histogram {
+    std::atomic<uint64_t> buckets[HISTOGRAM_BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> total;
+    std::atomic<uint64_t> min;
+    std::atomic<uint64_t> max;
+};
+
+struct TraceEvent {
+    uint64_t start;
+    uint64_t end;
+    MetricPhase phase;
+};
+
+// One thread's slots. Value-initialized, so every atomic starts at zero.
+struct ThreadMetrics {
+    int id = 0;
+    Histogram phases[PHASE_COUNT];
+    std::atomic<uint64_t> counters[COUNTER_COUNT];
+    std::vector<TraceEvent> trace;
+    uint64_t droppedEvents = 0;
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadMetrics>> threads; // Kept after their threads end, for the report
+    std::atomic<bool> tracing{ false };
+    uint64_t startTicks = 0;
+    std::chrono::steady_clock::time_point startTime;
+};
+
+// Never destroyed: threads still running at exit may record into it.
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+thread_local ThreadMetrics* current = nullptr;
+
+ThreadMetrics& local() {
+    if (current == nullptr) {
+        std::unique_ptr<ThreadMetrics> slots(new ThreadMetrics());
+        Registry& all = registry();
+        std::lock_guard<std::mutex> lock(all.mutex);
+        slots->id = static_cast<int>(all.threads.size());
+        current = slots.get();
+        all.threads.push_back(std::move(slots));
+    }
+    return *current;
+}
+
+// Converts ticks to nanoseconds. The TSC rate is measured over the whole
+// recording, at least 20 ms of it, against steady_clock.
+double ticksPerNanosecond() {
+#if defined(METRICS_TSC)
+    Registry& all = registry();
+    auto elapsed = std::chrono::steady_clock::now() - all.startTime;
+    if (elapsed < std::chrono::milliseconds(20)) std::this_thread::sleep_for(std::chrono::milliseconds(20) - elapsed);
+    uint64_t ticks = metricsTicks() - all.startTicks;
+    double nanoseconds = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - all.startTime).count());
+    return nanoseconds > 0 ? ticks / nanoseconds : 1.0;
+#else
+    using Period = std::chrono::steady_clock::period;
+    return static_cast<double>(Period::den) / (1e9 * Period::num);
+#endif
+}
+
+// --- Merging ---
+struct PhaseSummary {
+    uint64_t count = 0;
+    uint64_t total = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    std::vector<uint64_t> buckets = std::vector<uint64_t>(HISTOGRAM_BUCKETS);
+
+    // In ticks; q in [0, 1].
+    double percentile(double q) const {
+        if (count == 0) return 0.0;
+        uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * count)));
+        uint64_t seen = 0;
+        for (int b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+            seen += buckets[b];
+            if (seen >= rank) return std::min(std::max(bucketValue(b), double(min)), double(max));
+        }
+        return static_cast<double>(max);
+    }
+};
+
+struct Snapshot {
+    PhaseSummary phases[PHASE_COUNT];
+    uint64_t counters[COUNTER_COUNT] = {};
+    int threads = 0;
+    uint64_t droppedEvents = 0;
+    double ticksPerNs = 1.0;
+};
+
+Snapshot takeSnapshot() {
+    Snapshot snapshot;
+    snapshot.ticksPerNs = ticksPerNanosecond();
+    Registry& all = registry();
+    std::lock_guard<std::mutex> lock(all.mutex);
+    snapshot.threads = static_cast<int>(all.threads.size());
+    for (const auto& slots : all.threads) {
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            const Histogram& from = slots->phases[p];
+            PhaseSummary& into = snapshot.phases[p];
+            uint64_t count = read(from.count);
+            if (count == 0) continue;
+            into.min = (into.count == 0) ? read(from.min) : std::min(into.min, read(from.min));
+            into.max = std::max(into.max, read(from.max));
+            into.count += count;
+            into.total += read(from.total);
+            for (int b = 0; b < HISTOGRAM_BUCKETS; ++b) into.buckets[b] += read(from.buckets[b]);
+        }
+        for (int c = 0; c < COUNTER_COUNT; ++c) snapshot.counters[c] += read(slots->counters[c]);
+        snapshot.droppedEvents += slots->droppedEvents;
+    }
+    return snapshot;
+}
+
+// The columns every report shows, in nanoseconds.
+struct PhaseRow {
+    double mean, min, p50, p90, p99, p999, max, total;
+};
+
+PhaseRow phaseRow(const PhaseSummary& phase, double ticksPerNs) {
+    PhaseRow row{};
+    if (phase.count == 0) return row;
+    row.total = phase.total / ticksPerNs;
+    row.mean = row.total / phase.count;
+    row.min = phase.min / ticksPerNs;
+    row.p50 = phase.percentile(0.50) / ticksPerNs;
+    row.p90 = phase.percentile(0.90) / ticksPerNs;
+    row.p99 = phase.percentile(0.99) / ticksPerNs;
+    row.p999 = phase.percentile(0.999) / ticksPerNs;
+    row.max = phase.max / ticksPerNs;
+    return row;
+}
+
+bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+} // namespace
+
+// --- Recording ---
+bool enableMetrics(bool trace) {
+    Registry& all = registry();
+    if (!metricsEnabled()) {
+        all.startTime = std::chrono::steady_clock::now();
+        all.startTicks = metricsTicks();
+    }
+    if (trace) all.tracing = true;
+    metricsRecording = true;
+    local(); // The calling thread is thread 0
+    return true;
+}
+
+void recordPhase(MetricPhase phase, uint64_t startTicks, uint64_t endTicks) {
+    ThreadMetrics& slots = local();
+    uint64_t ticks = (endTicks > startTicks) ? endTicks - startTicks : 0; // The TSC may step back across cores
+    Histogram& histogram = slots.phases[static_cast<int>(phase)];
+    if (read(histogram.count) == 0 || ticks < read(histogram.min)) histogram.min.store(ticks, std::memory_order_relaxed);
+    if (ticks > read(histogram.max)) histogram.max.store(ticks, std::memory_order_relaxed);
+    bump(histogram.buckets[bucketOf(ticks)], 1);
+    bump(histogram.total, ticks);
+    bump(histogram.count, 1);
+    if (registry().tracing.load(std::memory_order_relaxed)) {
+        if (slots.trace.size() < TRACE_EVENTS_PER_THREAD) {
+            if (slots.trace.empty()) slots.trace.reserve(1 << 16);
+            slots.trace.push_back({ startTicks, endTicks, phase });
+        }
+        else {
+            ++slots.droppedEvents;
+        }
+    }
+}
+
+void countMetric(MetricCounter counter, uint64_t amount) {
+    bump(local().counters[static_cast<int>(counter)], amount);
+}
+
+// Heap allocations also go to the allocations counter while recording.
+// Only threads that have recorded something have slots; the rest go
+// uncounted rather than allocate slots from inside the allocator.
+namespace {
+
+void countAllocation() {
+    if (current != nullptr && metricsEnabled()) bump(current->counters[static_cast<int>(MetricCounter::Allocations)], 1);
+}
+
+} // namespace
+
+// --- Reports ---
+bool writeMetrics(const std::string& path, std::string& error) {
+    Snapshot snapshot = takeSnapshot();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+    if (endsWith(path, ".csv")) {
+        std::fprintf(file, "kind,name,count,total_ns,mean_ns,min_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns\n");
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            const PhaseSummary& phase = snapshot.phases[p];
+            PhaseRow row = phaseRow(phase, snapshot.ticksPerNs);
+            std::fprintf(file, "phase,%s,%llu,%.0f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f,%.1f\n", PHASE_NAMES[p],
+                         static_cast<unsigned long long>(phase.count), row.total, row.mean, row.min, row.p50, row.p90,
+                         row.p99, row.p999, row.max);
+        }
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            std::fprintf(file, "counter,%s,%llu,,,,,,,,\n", COUNTER_NAMES[c], static_cast<unsigned long long>(snapshot.counters[c]));
+        }
+    }
+    else {
+        std::fprintf(file, "{\n  \"clock\": \"%s\",\n  \"ticksPerNs\": %.6f,\n  \"threads\": %d,\n  \"droppedTraceEvents\": %llu,\n",
+#if defined(METRICS_TSC)
+                     "tsc",
+#else
+                     "steady_clock",
+#endif
+                     snapshot.ticksPerNs, snapshot.threads, static_cast<unsigned long long>(snapshot.droppedEvents));
+        std::fprintf(file, "  \"phases\": {\n");
+        for (int p = 0; p < PHASE_COUNT; ++p) {
+            const PhaseSummary& phase = snapshot.phases[p];
+            PhaseRow row = phaseRow(phase, snapshot.ticksPerNs);
+            std::fprintf(file,
+                         "    \"%s\": {\"count\": %llu, \"totalNs\": %.0f, \"meanNs\": %.1f, \"minNs\": %.1f, \"p50Ns\": %.1f, "
+                         "\"p90Ns\": %.1f, \"p99Ns\": %.1f, \"p999Ns\": %.1f, \"maxNs\": %.1f,\n      \"histogram\": [",
+                         PHASE_NAMES[p], static_cast<unsigned long long>(phase.count), row.total, row.mean, row.min,
+                         row.p50, row.p90, row.p99, row.p999, row.max);
+            // [value in ns, count] for every bucket anything landed in
+            bool first = true;
+            for (int b = 0; b < HISTOGRAM_BUCKETS; ++b) {
+                if (phase.buckets[b] == 0) continue;
+                std::fprintf(file, "%s[%.1f, %llu]", first ? "" : ", ", bucketValue(b) / snapshot.ticksPerNs,
+                             static_cast<unsigned long long>(phase.buckets[b]));
+                first = false;
+            }
+            std::fprintf(file, "]}%s\n", (p + 1 < PHASE_COUNT) ? "," : "");
+        }
+        std::fprintf(file, "  },\n  \"counters\": {");
+        for (int c = 0; c < COUNTER_COUNT; ++c) {
+            std::fprintf(file, "%s\"%s\": %llu", c ? ", " : "", COUNTER_NAMES[c], static_cast<unsigned long long>(snapshot.counters[c]));
+        }
+        std::fprintf(file, "}\n}\n");
+    }
+    bool ok = !std::ferror(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) error = "cannot write '" + path + "'";
+    return ok;
+}
+
+bool writeTrace(const std::string& path, std::string& error) {
+    double ticksPerNs = ticksPerNanosecond();
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "cannot create '" + path + "'";
+        return false;
+    }
+    Registry& all = registry();
+    std::lock_guard<std::mutex> lock(all.mutex);
+    std::fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    bool first = true;
+    for (const auto& slots : all.threads) {
+        std::string name = (slots->id == 0) ? "main" : "thread " + std::to_string(slots->id);
+        std::fprintf(file, "%s{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": \"%s\"}}",
+                     first ? "" : ",\n", slots->id, name.c_str());
+        first = false;
+        for (const TraceEvent& event : slots->trace) {
+            // Microseconds since recording began, as the format expects
+            double start = (event.start - all.startTicks) / ticksPerNs / 1000.0;
+            double duration = (event.end > event.start ? event.end - event.start : 0) / ticksPerNs / 1000.0;
+            std::fprintf(file, ",\n{\"name\": \"%s\", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                         PHASE_NAMES[static_cast<int>(event.phase)], slots->id, start, duration);
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    bool ok = !std::ferror(file);
+    ok = (std::fclose(file) == 0) && ok;
+    if (!ok) error = "cannot write '" + path + "'";
+    return ok;
+}
+
+void printMetrics(std::ostream& out) {
+    Snapshot snapshot = takeSnapshot();
+    out << " Phase          Count       Mean        p50        p99      p99.9        Max  (us)\n";
+    out << std::fixed << std::setprecision(2);
+    for (int p = 0; p < PHASE_COUNT; ++p) {
+        const PhaseSummary& phase = snapshot.phases[p];
+        if (phase.count == 0) continue;
+        PhaseRow row = phaseRow(phase, snapshot.ticksPerNs);
+        out << " " << std::left << std::setw(11) << PHASE_NAMES[p] << std::right << std::setw(9) << phase.count;
+        for (double value : { row.mean, row.p50, row.p99, row.p999, row.max }) out << std::setw(11) << value / 1000.0;
+        out << "\n";
+    }
+    out << " Counters:";
+    for (int c = 0; c < COUNTER_COUNT; ++c) out << (c ? ", " : " ") << COUNTER_NAMES[c] << " " << snapshot.counters[c];
+    out << "\n";
+    if (snapshot.droppedEvents > 0) out << " (" << snapshot.droppedEvents << " trace events dropped past the per-thread limit)\n";
+}
+
+#else
+
+bool enableMetrics(bool) {
+    return false;
+}
+
+bool writeMetrics(const std::string&, std::string& error) {
+    error = "this build has no metrics (ECHOGRID_METRICS=0)";
+    return false;
+}
+
+bool writeTrace(const std::string&, std::string& error) {
+    error = "this build has no metrics (ECHOGRID_METRICS=0)";
+    return false;
+}
+
+void printMetrics(std::ostream&) {}
+
+namespace {
+
+void countAllocation() {}
+
+} // namespace
+
+#endif
+
+// --- Allocation Counting ---
+// Heap allocations are counted by replacing the global operator new, in
+// every build: the per-thread count behind threadAllocations() is one
+// increment and needs no recording, so the benchmark suite can check that
+// the hot paths allocate nothing whatever the build.
+namespace {
+
+thread_local uint64_t allocationCount = 0;
+
+} // namespace
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete" // GCC assumes the library operator new
+#endif
+void* operator new(std::size_t bytes) {
+    ++allocationCount;
+    countAllocation();
+    if (bytes == 0) bytes = 1;
+    while (true) {
+        void* block = std::malloc(bytes);
+        if (block != nullptr) return block;
+        std::new_handler handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+    }
+}
+
+void operator delete(void* block) noexcept {
+    std::free(block);
+}
+
+void operator delete(void* block, std::size_t) noexcept {
+    std::free(block);
+}
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+uint64_t threadAllocations() {
+    return allocationCount;
+}
@@ -0,0 +1,130 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// --- Metrics ---
+// Where the time in a turn goes. Scoped timers record each phase (waiting
+// for input, drawing the board, presenting the frame, AI thinking, rule
+// checks, hints, whole games) into per-thread log-linear latency
+// histograms, and per-thread counters tally moves, conquers, defense saves
+// and heap allocations. Threads only ever touch their own slots; everything is
+// merged when a report is written.
+//
+// Recording is off until enableMetrics() (the --metrics and --trace
+// options), so a normal run pays one predictable branch per timer. Building
+// with ECHOGRID_METRICS=0 removes the timers and counters altogether.
+//
+// Timers read the TSC on x86 and steady_clock elsewhere; ticks are
+// converted to nanoseconds against steady_clock only when a report is
+// written, which assumes an invariant TSC (every x86 CPU of the last decade).
+
+#ifndef ECHOGRID_METRICS
+#define ECHOGRID_METRICS 1
+#endif
+
+#if ECHOGRID_METRICS && (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+#define METRICS_TSC 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+enum class MetricPhase {
+    InputWait, // Blocked on the player's answer
+    BoardDraw, // Composing the board into the frame
+    Present,   // Diffing the frame and sending it
+    AiThink,   // A strategy choosing its action
+    RuleCheck, // Win and draw checks after a turn
+    Game,      // One headless game, start to finish
+    ServerPump,// The server feeding one session its events
+    Hints,     // Evaluating every action for the hint overlay
+    Count
+};
+
+enum class MetricCounter {
+    Games,
+    Moves, // Turns played
+    ConquerAttempts,
+    ConquerSuccesses,
+    DefenseSaves,
+    Forfeits,
+    Allocations, // operator new calls on threads that have recorded anything
+    Count
+};
+
+const char* metricName(MetricPhase phase);
+const char* metricName(MetricCounter counter);
+
+// Starts recording; with trace, every timed phase is also kept as a trace
+// event. False if this build has no metrics.
+bool enableMetrics(bool trace);
+
+// Writes the merged histograms and counters: CSV if path ends in ".csv",
+// JSON otherwise.
+bool writeMetrics(const std::string& path, std::string& error);
+// Writes the trace events as a Chrome trace (chrome://tracing, Perfetto).
+// Call once the recording threads are done.
+bool writeTrace(const std::string& path, std::string& error);
+// A phase table and the counters, for the command line tools.
+void printMetrics(std::ostream& out);
+// What --metrics FILE and --trace FILE ask for; an empty path writes nothing.
+bool saveMetrics(const std::string& metricsPath, const std::string& tracePath, std::string& error);
+// operator new calls made by the calling thread so far, counted whether or
+// not recording is on, in builds without metrics too.
+uint64_t threadAllocations();
+
+#if ECHOGRID_METRICS
+
+extern std::atomic<bool> metricsRecording;
+
+inline bool metricsEnabled() {
+    return metricsRecording.load(std::memory_order_relaxed);
+}
+
+inline uint64_t metricsTicks() {
+#if defined(METRICS_TSC)
+    return __rdtsc();
+#else
+    return static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+void recordPhase(MetricPhase phase, uint64_t startTicks, uint64_t endTicks);
+void countMetric(MetricCounter counter, uint64_t amount);
+
+class ScopedTimer {
+public:
+    explicit ScopedTimer(MetricPhase phase) : phase(phase), start(metricsEnabled() ? metricsTicks() : 0) {}
+    ~ScopedTimer() {
+        if (start != 0) recordPhase(phase, start, metricsTicks());
+    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    MetricPhase phase;
+    uint64_t start;
+};
+
+#define METRICS_JOIN2(a, b) a##b
+#define METRICS_JOIN(a, b) METRICS_JOIN2(a, b)
+// Times the rest of the enclosing block as MetricPhase::phase.
+#define METRICS_SCOPE(phase) ScopedTimer METRICS_JOIN(metricsTimer, __LINE__)(MetricPhase::phase)
+#define METRICS_ADD(counter, amount) \
+    do { if (metricsEnabled()) countMetric(MetricCounter::counter, (amount)); } while (0)
+
+#else
+
+inline bool metricsEnabled() { return false; }
+
+#define METRICS_SCOPE(phase) do {} while (0)
+#define METRICS_ADD(counter, amount) do {} while (0)
+
+#endif
+
+#define METRICS_COUNT(counter) METRICS_ADD(counter, 1)
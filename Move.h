@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include "Board.h"
+#include "FixedBoard.h"
+
+// --- Make and Unmake ---
+// Turns are applied to a board in place and taken back exactly, rather than
+// by keeping copies of the board. makeMove is one whole turn: the mover
+// claims square (placing on an empty one, or taking one on a won conquer;
+// -1 when the turn claims nothing, as after a forfeit or a saved square)
+// and the turn passes. What it returns restores both.
+//
+// Works on Board and every FixedBoard specialization.
+
+struct MoveUndo {
+    int16_t square = -1;  // Claimed by the turn, or -1
+    char previous = '\0'; // Its owner before the turn, '\0' if it was empty
+    uint8_t toMove = 1;   // Side to move before the turn
+};
+
+template <typename BoardType>
+inline MoveUndo makeMove(BoardType& board, int square, char playerSymbol) {
+    MoveUndo undo;
+    undo.square = static_cast<int16_t>(square);
+    undo.toMove = board.toMove;
+    if (square >= 0) {
+        undo.previous = cellSymbol(board, square);
+        setCell(board, square, playerSymbol);
+    }
+    board.toMove = (board.toMove == 1) ? 2 : 1;
+    return undo;
+}
+
+template <typename BoardType>
+inline void unmakeMove(BoardType& board, const MoveUndo& undo) {
+    if (undo.square >= 0) {
+        if (undo.previous == '\0') clearCell(board, undo.square);
+        else setCell(board, undo.square, undo.previous);
+    }
+    board.toMove = undo.toMove;
+}
+
+// --- Move Lists ---
+// The squares an action can target, in ascending order, generated into a
+// buffer sized for the largest board. Lives on the stack; listing moves
+// never allocates.
+struct MoveList {
+    int16_t squares[MAX_CELLS];
+    int count = 0;
+
+    void add(int square) { squares[count++] = static_cast<int16_t>(square); }
+    int operator[](int i) const { return squares[i]; }
+};
+
+// Every empty square.
+template <typename BoardType>
+inline void generatePlacements(const BoardType& board, MoveList& moves) {
+    moves.count = 0;
+    for (int i = 0; i < cellCount(board); ++i) {
+        if (isEmptySquare(board, i)) moves.add(i);
+    }
+}
+
+// Every square held by playerSymbol's opponent.
+template <typename BoardType>
+inline void generateConquests(const BoardType& board, char playerSymbol, MoveList& moves) {
+    char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+    moves.count = 0;
+    for (int i = 0; i < cellCount(board); ++i) {
+        if (cellSymbol(board, i) == opponentSymbol) moves.add(i);
+    }
+}
+
+// --- Turn History ---
+// The latest turns of one game in a fixed ring, oldest first. Once it is
+// full the oldest turn drops off, so recording a turn never allocates and
+// take-backs reach at most Capacity turns. clear() readies it for the next
+// game.
+template <typename Entry, int Capacity>
+class HistoryRing {
+public:
+    void clear() { first = count = 0; }
+    bool empty() const { return count == 0; }
+    int size() const { return count; }
+
+    void push(const Entry& entry) {
+        if (count == Capacity) {
+            first = (first + 1) % Capacity;
+            --count;
+        }
+        entries[(first + count) % Capacity] = entry;
+        ++count;
+    }
+
+    const Entry& back() const { return entries[(first + count - 1) % Capacity]; } // Requires !empty()
+    void pop() { --count; }                                                         // Requires !empty()
+
+private:
+    Entry entries[Capacity];
+    int first = 0;
+    int count = 0;
+};
@@ -0,0 +1,265 @@
+#include "Policy.h"
+#include "Board.h" // For countBits
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h> // For CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+uint32_t boardIndex(uint16_t ownMarks, uint16_t opponentMarks) {
+    uint32_t index = 0;
+    for (int i = POLICY_CELLS - 1; i >= 0; --i) {
+        index = index * 3 + ((ownMarks >> i) & 1) + 2 * ((opponentMarks >> i) & 1);
+    }
+    return index;
+}
+
+// --- Memory-Mapped Loading ---
+PolicyTable::~PolicyTable() {
+    unload();
+}
+
+bool PolicyTable::load(const char* path) {
+    unload();
+    size_t expectedSize = sizeof(PolicyHeader) + POLICY_ENTRIES * sizeof(PolicyEntry);
+
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || static_cast<size_t>(size.QuadPart) != expectedSize) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // The mapping keeps the file open
+    if (view == nullptr) return false;
+    void* data = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(view);
+        return false;
+    }
+    fileMapping = view;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) != expectedSize) {
+        close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, expectedSize, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd); // The mapping keeps the file open
+    if (data == MAP_FAILED) return false;
+#endif
+    mapping = data;
+    mappedSize = expectedSize;
+
+    const PolicyHeader* header = static_cast<const PolicyHeader*>(data);
+    if (std::memcmp(header->magic, "EGPT", 4) != 0 || header->version != POLICY_VERSION ||
+        header->entryCount != POLICY_ENTRIES) {
+        unload();
+        return false;
+    }
+    entries = reinterpret_cast<const PolicyEntry*>(header + 1);
+    return true;
+}
+
+void PolicyTable::unload() {
+    if (mapping == nullptr) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping);
+    CloseHandle(fileMapping);
+    fileMapping = nullptr;
+#else
+    munmap(mapping, mappedSize);
+#endif
+    mapping = nullptr;
+    mappedSize = 0;
+    entries = nullptr;
+}
+
+// --- Expectimax Solver ---
+// Placing always adds a mark, but a conquer (or a failed one) leaves the mark
+// count unchanged, so positions with the same number of marks can cycle into
+// each other. The solver therefore works layer by layer from full boards down
+// to the empty one, and inside a layer iterates to a fixed point. Each pass is
+// a contraction (the normal-turn half always leaves the layer), so it
+// converges to double precision in a few dozen sweeps.
+
+namespace {
+
+const double CONVERGENCE_EPSILON = 1e-15;
+const double TIE_EPSILON = 1e-12; // Prefer the earlier action on near-ties
+
+// Bit i of a mask is square i + 1. Rows, columns, then the two diagonals.
+const uint16_t FULL_BOARD = 0x1FF;
+const uint16_t WIN_MASKS[8] = { 0x007, 0x038, 0x1C0, 0x049, 0x092, 0x124, 0x111, 0x054 };
+
+bool hasLine(uint16_t marks) {
+    for (uint16_t line : WIN_MASKS) {
+        if ((marks & line) == line) {
+            return true;
+        }
+    }
+    return false;
+}
+
+struct Position {
+    uint16_t own;
+    uint16_t opponent;
+};
+
+Position decodeBoard(uint32_t index) {
+    Position p = { 0, 0 };
+    for (int i = 0; i < POLICY_CELLS; ++i, index /= 3) {
+        if (index % 3 == 1) p.own |= 1u << i;
+        if (index % 3 == 2) p.opponent |= 1u << i;
+    }
+    return p;
+}
+
+struct Decision {
+    double value;
+    uint8_t action;
+};
+
+// value[t] is the pre-toss expected score for the mover in ternary position t.
+double outcomeAfterMove(const std::vector<double>& value, uint16_t own, uint16_t opponent) {
+    if (hasLine(own)) return 1.0;
+    if ((own | opponent) == FULL_BOARD) return 0.5;
+    return 1.0 - value[boardIndex(opponent, own)];
+}
+
+Decision bestPlace(const std::vector<double>& value, const Position& p) {
+    Decision best = { -1.0, POLICY_NO_ACTION };
+    uint16_t empty = FULL_BOARD & ~(p.own | p.opponent);
+    for (int i = 0; i < POLICY_CELLS; ++i) {
+        uint16_t bit = static_cast<uint16_t>(1u << i);
+        if (!(empty & bit)) continue;
+        double v = outcomeAfterMove(value, p.own | bit, p.opponent);
+        if (v > best.value + TIE_EPSILON) best = { v, static_cast<uint8_t>(i) };
+    }
+    return best;
+}
+
+Decision bestConquer(const std::vector<double>& value, const Position& p) {
+    Decision best = { -1.0, POLICY_NO_ACTION };
+    double defended = 1.0 - value[boardIndex(p.opponent, p.own)];
+    for (int i = 0; i < POLICY_CELLS; ++i) {
+        uint16_t bit = static_cast<uint16_t>(1u << i);
+        if (!(p.opponent & bit)) continue;
+        double taken = outcomeAfterMove(value, p.own | bit, p.opponent & ~bit);
+        double v = 0.5 * defended + 0.5 * taken;
+        if (v > best.value + TIE_EPSILON) best = { v, static_cast<uint8_t>(POLICY_CONQUER_BASE + i) };
+    }
+    return best;
+}
+
+Decision bestPower(const std::vector<double>& value, const Position& p) {
+    Decision place = bestPlace(value, p);
+    Decision conquer = bestConquer(value, p);
+    return (conquer.value > place.value + TIE_EPSILON) ? conquer : place;
+}
+
+bool isTerminal(const Position& p) {
+    return hasLine(p.own) || hasLine(p.opponent) || (p.own | p.opponent) == FULL_BOARD;
+}
+
+double terminalValue(const Position& p) {
+    if (hasLine(p.own)) return 1.0;
+    if (hasLine(p.opponent)) return 0.0;
+    return 0.5;
+}
+
+uint16_t toScore(double value) {
+    return static_cast<uint16_t>(std::lround(value * 65535.0));
+}
+
+} // namespace
+
+std::vector<PolicyEntry> solvePolicy() {
+    std::vector<Position> positions(POLICY_BOARDS);
+    std::vector<std::vector<uint32_t>> layers(POLICY_CELLS + 1);
+    for (uint32_t t = 0; t < POLICY_BOARDS; ++t) {
+        Position p = decodeBoard(t);
+        positions[t] = p;
+        layers[countBits(static_cast<uint32_t>(p.own | p.opponent))].push_back(t);
+    }
+
+    std::vector<double> value(POLICY_BOARDS, 0.0);
+    for (int layer = POLICY_CELLS; layer >= 0; --layer) {
+        for (uint32_t t : layers[layer]) {
+            if (isTerminal(positions[t])) value[t] = terminalValue(positions[t]);
+        }
+        double delta;
+        do {
+            delta = 0.0;
+            for (uint32_t t : layers[layer]) {
+                const Position& p = positions[t];
+                if (isTerminal(p)) continue;
+                double v = 0.5 * bestPlace(value, p).value + 0.5 * bestPower(value, p).value;
+                delta = std::max(delta, std::fabs(v - value[t]));
+                value[t] = v;
+            }
+        } while (delta > CONVERGENCE_EPSILON);
+    }
+
+    std::vector<PolicyEntry> entries(POLICY_ENTRIES);
+    for (uint32_t t = 0; t < POLICY_BOARDS; ++t) {
+        const Position& p = positions[t];
+        PolicyEntry normal = { toScore(value[t]), POLICY_NO_ACTION, 0 };
+        PolicyEntry power = normal;
+        if (!isTerminal(p)) {
+            Decision placeDecision = bestPlace(value, p);
+            Decision powerDecision = bestPower(value, p);
+            normal = { toScore(placeDecision.value), placeDecision.action, 0 };
+            power = { toScore(powerDecision.value), powerDecision.action, 0 };
+        }
+        entries[t * 2] = normal;
+        entries[t * 2 + 1] = power;
+    }
+    return entries;
+}
+
+bool writePolicy(const char* path, const std::vector<PolicyEntry>& entries) {
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) return false;
+    PolicyHeader header = { { 'E', 'G', 'P', 'T' }, POLICY_VERSION, static_cast<uint32_t>(entries.size()), 0 };
+    bool ok = std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+              std::fwrite(entries.data(), sizeof(PolicyEntry), entries.size(), file) == entries.size();
+    return std::fclose(file) == 0 && ok;
+}
+
+int verifyPolicy(const char* path) {
+    PolicyTable table;
+    if (!table.load(path)) {
+        std::cout << "Could not load policy table '" << path << "'.\n";
+        return -1;
+    }
+    std::vector<PolicyEntry> solved = solvePolicy();
+    int mismatches = 0;
+    for (uint32_t t = 0; t < POLICY_BOARDS; ++t) {
+        Position p = decodeBoard(t);
+        for (int power = 0; power < 2; ++power) {
+            const PolicyEntry& stored = table.lookup(p.own, p.opponent, power != 0);
+            const PolicyEntry& fresh = solved[t * 2 + power];
+            // Allow one step of rounding slack in the quantized score
+            if (stored.action != fresh.action || std::abs(stored.score - fresh.score) > 1) {
+                ++mismatches;
+            }
+        }
+    }
+    std::cout << "Checked " << POLICY_ENTRIES << " policy entries: " << mismatches << " mismatch(es).\n";
+    return mismatches;
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// --- Solved Policy Table ---
+// The coin toss, conquer option and defense toss make EchoGrid a stochastic
+// game, but on the classic board a tiny one: every position is a 3x3
+// ternary board plus whose turn it is and whether they won the power-turn
+// toss. The offline solver runs expectimax over all of them and stores the
+// exact expected score (win = 1, draw = 1/2) and the best action for each.
+//
+// Positions are stored from the mover's point of view. The rules treat both
+// sides identically, so "Blue to move" and "Red to move" on mirrored boards
+// share one entry, which folds the side-to-move dimension out of the table.
+
+const char POLICY_FILE[] = "EchoGrid.policy";
+
+const uint8_t POLICY_NO_ACTION = 0xFF;    // Terminal position, nothing to do
+const uint8_t POLICY_CONQUER_BASE = 9;    // Actions 0-8 place, 9-17 conquer
+
+struct PolicyEntry {
+    uint16_t score;   // Expected score for the mover, scaled to 0..65535
+    uint8_t action;   // Square index, plus POLICY_CONQUER_BASE for a conquer
+    uint8_t reserved;
+};
+
+struct PolicyHeader {
+    char magic[4];        // "EGPT"
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+const int POLICY_CELLS = 9;
+const uint32_t POLICY_VERSION = 1;
+const uint32_t POLICY_BOARDS = 19683; // 3^9
+const uint32_t POLICY_ENTRIES = POLICY_BOARDS * 2;
+
+// Ternary index of a board: digit i is 0 (empty), 1 (mover) or 2 (opponent).
+uint32_t boardIndex(uint16_t ownMarks, uint16_t opponentMarks);
+
+inline uint32_t policyIndex(uint16_t ownMarks, uint16_t opponentMarks, bool powerTurn) {
+    return boardIndex(ownMarks, opponentMarks) * 2 + (powerTurn ? 1 : 0);
+}
+
+inline bool isConquerAction(uint8_t action) {
+    return action != POLICY_NO_ACTION && action >= POLICY_CONQUER_BASE;
+}
+
+inline int actionSquare(uint8_t action) {
+    return isConquerAction(action) ? action - POLICY_CONQUER_BASE : action;
+}
+
+// Read-only view of a policy file, memory-mapped so lookups touch the page
+// cache directly and startup costs nothing beyond the mapping itself.
+class PolicyTable {
+public:
+    PolicyTable() = default;
+    ~PolicyTable();
+    PolicyTable(const PolicyTable&) = delete;
+    PolicyTable& operator=(const PolicyTable&) = delete;
+
+    bool load(const char* path);
+    void unload();
+    bool isLoaded() const { return entries != nullptr; }
+
+    const PolicyEntry& lookup(uint16_t ownMarks, uint16_t opponentMarks, bool powerTurn) const {
+        return entries[policyIndex(ownMarks, opponentMarks, powerTurn)];
+    }
+
+private:
+    const PolicyEntry* entries = nullptr;
+    void* mapping = nullptr;
+    size_t mappedSize = 0;
+#if defined(_WIN32)
+    void* fileMapping = nullptr;
+#endif
+};
+
+// --- Offline Solver ---
+std::vector<PolicyEntry> solvePolicy();
+bool writePolicy(const char* path, const std::vector<PolicyEntry>& entries);
+
+// Re-solves the game and compares it against the table on disk. Prints a
+// summary and returns the number of mismatching entries (or -1 if the file
+// could not be loaded).
+int verifyPolicy(const char* path);
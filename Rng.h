@@ -0,0 +1,74 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <random> // For random_device
+
+// --- Random Number Generation ---
+// Every game owns its own generator and passes it to whatever draws
+// randomness (dice, coin calls and tosses, defense tosses, AI choices).
+// Nothing is shared between threads, and (seed, game index) fully determines
+// a game, so any game from a parallel batch can be replayed bit for bit.
+//
+// The generator is xoshiro256** seeded through splitmix64.
+class Rng {
+public:
+    explicit Rng(uint64_t seed, uint64_t gameIndex = 0) {
+        uint64_t x = seed;
+        uint64_t mixed = splitmix64(x) ^ (gameIndex * 0xD1B54A32D192ED03ull);
+        for (uint64_t& word : state) {
+            word = splitmix64(mixed);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform in [0, n) without modulo bias (Lemire's multiply-and-reject).
+    uint32_t below(uint32_t n) {
+        uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * n;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < n) {
+            uint32_t threshold = (0u - n) % n;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * n;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // 1..sides, as in a die roll (6) or a coin call/toss (2).
+    int roll(int sides) {
+        return static_cast<int>(below(static_cast<uint32_t>(sides))) + 1;
+    }
+
+private:
+    uint64_t state[4];
+
+    static uint64_t rotl(uint64_t x, int k) {
+        return (x << k) | (x >> (64 - k));
+    }
+
+    static uint64_t splitmix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+// A seed for games that were not given one explicitly.
+inline uint64_t randomSeed() {
+    std::random_device device;
+    uint64_t entropy = (static_cast<uint64_t>(device()) << 32) ^ device();
+    return entropy ^ static_cast<uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
@@ -0,0 +1,242 @@
+#include "Screen.h"
+#include <algorithm>
+#include "Metrics.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h> // For virtual terminal mode and WriteFile
+#else
+#include <cerrno>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// ANSI foreground code for a console attribute (30-37, 90-97 when bright).
+int ansiColor(uint8_t attribute) {
+    int red = (attribute & 4) ? 1 : 0;
+    int green = (attribute & 2) ? 2 : 0;
+    int blue = (attribute & 1) ? 4 : 0;
+    return ((attribute & 8) ? 90 : 30) + red + green + blue;
+}
+
+void appendNumber(std::string& out, int value) {
+    char digits[12];
+    int count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    } while (value > 0);
+    while (count > 0) out += digits[--count];
+}
+
+void moveCursor(std::string& out, int row, int col) {
+    out += "\x1b[";
+    appendNumber(out, row + 1);
+    out += ';';
+    appendNumber(out, col + 1);
+    out += 'H';
+}
+
+void selectColor(std::string& out, uint8_t attribute) {
+    out += "\x1b[";
+    appendNumber(out, ansiColor(attribute));
+    out += 'm';
+}
+
+} // namespace
+
+Screen::Screen(ScreenTarget target) : target(target) {
+#if defined(_WIN32)
+    if (target == ScreenTarget::Terminal) {
+        HANDLE console = GetStdHandle(STD_OUTPUT_HANDLE);
+        DWORD mode = 0;
+        if (GetConsoleMode(console, &mode)) {
+            SetConsoleMode(console, mode | ENABLE_VIRTUAL_TERMINAL_PROCESSING);
+        }
+    }
+#endif
+}
+
+void Screen::clear() {
+    if (transcript != nullptr) appendFrameText(*transcript);
+    frame.clear();
+    cursorRow = 0;
+    cursorCol = 0;
+}
+
+void Screen::setColor(int newColor) {
+    color = static_cast<uint8_t>(newColor);
+}
+
+Screen& Screen::operator<<(const std::string& text) {
+    for (char ch : text) put(ch);
+    return *this;
+}
+
+Screen& Screen::operator<<(const char* text) {
+    while (*text != '\0') put(*text++);
+    return *this;
+}
+
+Screen& Screen::operator<<(char c) {
+    put(c);
+    return *this;
+}
+
+void Screen::put(char ch) {
+    if (ch == '\n') {
+        ++cursorRow;
+        cursorCol = 0;
+        return;
+    }
+    if (static_cast<int>(frame.size()) <= cursorRow) frame.resize(cursorRow + 1);
+    std::vector<Cell>& cells = frame[cursorRow].cells;
+    if (static_cast<int>(cells.size()) <= cursorCol) cells.resize(cursorCol + 1);
+    cells[cursorCol++] = Cell{ch, color};
+}
+
+void Screen::present() {
+    METRICS_SCOPE(Present);
+    output.clear();
+    if (firstFrame) {
+        output += "\x1b[H\x1b[2J"; // Once, to start from a known terminal
+        firstFrame = false;
+    }
+
+    auto moveTo = [&](int row, int col) {
+        if (row != terminalRow || col != terminalCol) moveCursor(output, row, col);
+        terminalRow = row;
+        terminalCol = col;
+    };
+    size_t rows = std::max(frame.size(), terminal.size());
+    static const Row blankRow;
+    for (size_t r = 0; r < rows; ++r) {
+        const Row& next = r < frame.size() ? frame[r] : blankRow;
+        const Row& shown = r < terminal.size() ? terminal[r] : blankRow;
+        const std::vector<Cell>& cells = next.cells;
+        const std::vector<Cell>& old = shown.cells;
+        int row = static_cast<int>(r);
+
+        if (shown.unknown) {
+            moveTo(row, 0);
+            output += "\x1b[2K";
+        }
+        size_t col = 0;
+        while (col < cells.size()) {
+            bool same = !shown.unknown && col < old.size() && cells[col] == old[col];
+            if (same) {
+                ++col;
+                continue;
+            }
+            // Send the changed run, with at most one cursor move.
+            moveTo(row, static_cast<int>(col));
+            while (col < cells.size() && (shown.unknown || col >= old.size() || cells[col] != old[col])) {
+                if (cells[col].color != terminalColor) {
+                    selectColor(output, cells[col].color);
+                    terminalColor = cells[col].color;
+                }
+                output += cells[col].ch;
+                ++terminalCol;
+                ++counters.cellsChanged;
+                ++col;
+            }
+        }
+        if (!shown.unknown && old.size() > cells.size()) {
+            moveTo(row, static_cast<int>(cells.size()));
+            output += "\x1b[K";
+        }
+    }
+
+    // Park the cursor where text would continue, in the current color, so
+    // anything the user types is echoed in place.
+    moveTo(cursorRow, cursorCol);
+    if (color != terminalColor) {
+        selectColor(output, color);
+        terminalColor = color;
+    }
+
+    terminal = frame;
+    ++counters.frames;
+    send(output);
+}
+
+void Screen::echoInput(const std::string& line) {
+    *this << line;
+    if (static_cast<int>(frame.size()) <= cursorRow) frame.resize(cursorRow + 1);
+    if (static_cast<int>(terminal.size()) <= cursorRow) terminal.resize(cursorRow + 1);
+    terminal[cursorRow].unknown = true;
+    put('\n');
+    terminalRow = cursorRow; // The Enter key moved the terminal cursor too
+    terminalCol = 0;
+}
+
+void Screen::noteStrayInput() {
+    if (static_cast<int>(terminal.size()) <= cursorRow) terminal.resize(cursorRow + 1);
+    terminal[cursorRow].unknown = true;
+    forgetCursor();
+}
+
+void Screen::forgetCursor() {
+    terminalRow = -1;
+    terminalCol = -1;
+}
+
+void Screen::forgetTerminal() {
+    terminal.clear();
+    forgetCursor();
+    terminalColor = -1;
+    firstFrame = true;
+}
+
+std::string Screen::takeOutput() {
+    std::string taken;
+    taken.swap(buffered);
+    return taken;
+}
+
+void Screen::finish() {
+    if (transcript != nullptr) appendFrameText(*transcript);
+    present();
+    std::string reset = "\x1b[0m";
+    moveCursor(reset, static_cast<int>(frame.size()), 0);
+    send(reset);
+}
+
+// One line per row, without trailing blanks; empty frames are skipped.
+void Screen::appendFrameText(std::string& log) const {
+    if (frame.empty()) return;
+    log += "--- Frame ---\n";
+    for (const Row& row : frame) {
+        size_t end = row.cells.size();
+        while (end > 0 && row.cells[end - 1].ch == ' ') --end;
+        for (size_t c = 0; c < end; ++c) log += row.cells[c].ch;
+        log += '\n';
+    }
+}
+
+void Screen::send(const std::string& bytes) {
+    counters.bytes += bytes.size();
+    if (target == ScreenTarget::Discard) return;
+    ++counters.writes;
+    if (target == ScreenTarget::Buffer) {
+        buffered += bytes;
+        return;
+    }
+#if defined(_WIN32)
+    DWORD written = 0;
+    WriteFile(GetStdHandle(STD_OUTPUT_HANDLE), bytes.data(), static_cast<DWORD>(bytes.size()), &written, nullptr);
+#else
+    const char* data = bytes.data();
+    size_t remaining = bytes.size();
+    while (remaining > 0) {
+        ssize_t written = ::write(STDOUT_FILENO, data, remaining);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += written;
+        remaining -= static_cast<size_t>(written);
+    }
+#endif
+}
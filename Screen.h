@@ -0,0 +1,120 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// --- Console Color Constants ---
+// Windows console attribute values (bit 0 blue, 1 green, 2 red, 3 bright),
+// translated to ANSI colors when a frame is sent.
+const int COLOR_BLUE = 9;
+const int COLOR_RED = 12;
+const int COLOR_WHITE = 15;
+const int COLOR_YELLOW = 14;
+const int COLOR_GREEN = 10;
+const int COLOR_GREY = 8;
+
+// --- Frame-Buffered Screen ---
+// The game writes each frame into an in-memory grid of colored cells with
+// the same "set a color, stream some text" calls it used to send to the
+// console. present() compares the frame with the one already on the
+// terminal and sends only the cells that changed: cursor moves, color
+// changes and text, in a single write using ANSI escape sequences. Nothing
+// is ever cleared on the terminal, so large boards redraw without flicker.
+//
+// Works on any ANSI terminal; on Windows it switches the console into
+// virtual terminal mode first.
+enum class ScreenTarget {
+    Terminal, // Standard output
+    Buffer,   // Kept for takeOutput(), e.g. to send over a socket
+    Discard   // Composed and diffed but never sent, as the benchmarks use it
+};
+
+class Screen {
+public:
+    explicit Screen(ScreenTarget target = ScreenTarget::Terminal);
+
+    // Starts a new, empty frame. The terminal is untouched until present().
+    void clear();
+    void setColor(int color);
+
+    Screen& operator<<(const std::string& text);
+    Screen& operator<<(const char* text);
+    Screen& operator<<(char c);
+
+    template <typename Number, typename = std::enable_if_t<std::is_arithmetic<Number>::value>>
+    Screen& operator<<(Number value) {
+        return *this << std::to_string(value);
+    }
+
+    // Sends the changes since the last present and leaves the terminal cursor
+    // where the next text would go, so typed input appears there.
+    void present();
+
+    // Records a line the user typed (and the terminal echoed) at the cursor,
+    // then moves to the next line as the terminal did.
+    void echoInput(const std::string& line);
+
+    // Input was typed while no prompt was showing. The terminal echoed it at
+    // the cursor, so that row and the cursor are repainted on the next present.
+    void noteStrayInput();
+
+    // The next present positions the cursor explicitly. For viewers whose
+    // terminals did not all echo the same input.
+    void forgetCursor();
+
+    // The next present clears the terminal and draws the whole frame, as for
+    // a viewer who has seen none of the earlier ones.
+    void forgetTerminal();
+
+    // Appends every frame to log as plain text once it is done with: when
+    // clear() starts the next one, and at finish(). Colors are left out.
+    void setTranscript(std::string* log) { transcript = log; }
+
+    // What a Buffer screen has sent since the last call.
+    std::string takeOutput();
+
+    // Presents the last frame and leaves the terminal in its default colors
+    // on the line below it.
+    void finish();
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t writes = 0;
+        uint64_t bytes = 0;
+        uint64_t cellsChanged = 0;
+    };
+    const Stats& stats() const { return counters; }
+
+private:
+    struct Cell {
+        char ch = ' ';
+        uint8_t color = COLOR_WHITE;
+        bool operator==(const Cell& other) const { return ch == other.ch && color == other.color; }
+        bool operator!=(const Cell& other) const { return !(*this == other); }
+    };
+
+    struct Row {
+        std::vector<Cell> cells;
+        bool unknown = false; // Terminal contents no longer match (e.g. echoed input)
+    };
+
+    void put(char ch);
+    void send(const std::string& bytes);
+    void appendFrameText(std::string& log) const;
+
+    std::vector<Row> frame;     // Being composed
+    std::vector<Row> terminal;  // What the terminal shows
+    int cursorRow = 0;
+    int cursorCol = 0;
+    uint8_t color = COLOR_WHITE;
+    int terminalRow = -1;       // Terminal cursor and color, once known
+    int terminalCol = -1;
+    int terminalColor = -1;
+    ScreenTarget target;
+    bool firstFrame = true;
+    std::string output;         // Reused between presents
+    std::string buffered;       // For ScreenTarget::Buffer
+    std::string* transcript = nullptr;
+    Stats counters;
+};
@@ -0,0 +1,1247 @@
+#include "Server.h"
+#include <iostream>
+
+#if defined(__linux__)
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <queue>
+#include <signal.h>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <unordered_map>
+#include <vector>
+#include "Game.h"
+#include "Metrics.h"
+#include "Policy.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+const int DEFAULT_PORT = 7777;
+const char* MARKER_START = "\x1b]echogrid;";
+const char MARKER_END = '\x07';
+const int SPECTATOR_BACKLOG = 8;                        // Frames a game keeps for spectators catching up
+const auto SPECTATOR_STALL = std::chrono::seconds(10);  // A spectator whose socket takes nothing this long is dropped
+const size_t GAMES_LISTED = 10;                         // Newest games offered to a new spectator
+const auto SPECTATOR_RETRY = std::chrono::milliseconds(50); // Load spectators wait this long to ask again for a game
+const char* SERVE_USAGE =
+    "Usage: EchoGrid --serve [--port P | --unix PATH] [--workers N] [--size N] [--win K]\n"
+    "       [--ai NAME] [--ai-ms MS] [--ai-playouts P] [--seed S] [--speed F | --fast] [--sessions N]\n"
+    "       [--metrics FILE] [--trace FILE]\n";
+const char* LOAD_USAGE =
+    "Usage: EchoGrid --load [--port P | --unix PATH] [--sessions N] [--concurrency C] [--spectators W]\n"
+    "       [--size N] [--seed S]\n";
+
+// --- Sockets ---
+struct Endpoint {
+    int port = DEFAULT_PORT;
+    std::string unixPath; // Used instead of TCP when set
+};
+
+bool setNonBlocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+int openSocket(const Endpoint& endpoint, bool listening) {
+    int fd = -1;
+    int result = -1;
+    if (!endpoint.unixPath.empty()) {
+        sockaddr_un address{};
+        address.sun_family = AF_UNIX;
+        std::strncpy(address.sun_path, endpoint.unixPath.c_str(), sizeof(address.sun_path) - 1);
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        if (listening) {
+            unlink(endpoint.unixPath.c_str());
+            result = bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+        else {
+            setNonBlocking(fd);
+            result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+    }
+    else {
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(static_cast<uint16_t>(endpoint.port));
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0) return -1;
+        int on = 1;
+        if (listening) {
+            setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+            result = bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+        else {
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+            setNonBlocking(fd);
+            result = connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+        }
+    }
+    if (listening && result == 0) result = listen(fd, SOMAXCONN);
+    if (listening && result == 0) result = setNonBlocking(fd) ? 0 : -1;
+    if (result != 0 && !(result < 0 && errno == EINPROGRESS)) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+// Reads "--port P" or "--unix PATH" at argv[i]; valid is false for a port
+// that is not a number from 1 to 65535.
+bool parseEndpoint(const std::string& arg, int& i, int argc, char* argv[], Endpoint& endpoint, bool& valid) {
+    if (i + 1 >= argc) return false;
+    if (arg == "--port") valid = parseNumber(argv[++i], endpoint.port) && endpoint.port >= 1 && endpoint.port <= 65535;
+    else if (arg == "--unix") endpoint.unixPath = argv[++i];
+    else return false;
+    return true;
+}
+
+std::string marker(const char* kind) {
+    return std::string(MARKER_START) + kind + MARKER_END;
+}
+
+const char* promptKind(Game::Prompt prompt) {
+    switch (prompt) {
+    case Game::Prompt::Start: return "start";
+    case Game::Prompt::Call: return "call";
+    case Game::Prompt::Action: return "action";
+    case Game::Prompt::Place: return "place";
+    case Game::Prompt::Conquer: return "conquer";
+    case Game::Prompt::Defense: return "defense";
+    default: return nullptr;
+    }
+}
+
+// --- AI Worker Pool ---
+// Runs Game::think off the event loop and signals an eventfd when results
+// are ready. The session does nothing else while its game is out here.
+class AiWorkers {
+public:
+    AiWorkers(int threads, int notifyFd) : notifyFd(notifyFd) {
+        for (int t = 0; t < threads; ++t) pool.emplace_back([this]() { work(); });
+    }
+
+    ~AiWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        ready.notify_all();
+        for (std::thread& thread : pool) thread.join();
+    }
+
+    void submit(uint64_t session, Game* game) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back({session, game});
+        }
+        ready.notify_one();
+    }
+
+    std::vector<std::pair<uint64_t, TurnAction>> takeDone() {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<std::pair<uint64_t, TurnAction>> taken;
+        taken.swap(done);
+        return taken;
+    }
+
+private:
+    void work() {
+        while (true) {
+            std::pair<uint64_t, Game*> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                ready.wait(lock, [this]() { return stopping || !jobs.empty(); });
+                if (stopping) return;
+                job = jobs.front();
+                jobs.pop_front();
+            }
+            TurnAction action = job.second->think();
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                done.push_back({job.first, action});
+            }
+            uint64_t one = 1;
+            ssize_t ignored = write(notifyFd, &one, sizeof(one));
+            (void)ignored;
+        }
+    }
+
+    int notifyFd;
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::pair<uint64_t, Game*>> jobs;
+    std::vector<std::pair<uint64_t, TurnAction>> done;
+    bool stopping = false;
+    std::vector<std::thread> pool;
+};
+
+// --- Spectator Broadcast ---
+// Everyone watching a game is fed from one channel. Each change to the game
+// is drawn once into an immutable, shared frame, both as the diff from the
+// previous frame and as a full redraw, and every spectator is sent those
+// same bytes; nothing is copied per viewer. The channel keeps the newest
+// SPECTATOR_BACKLOG frames and a spectator holds only its place in them and
+// the frame it is partway through, so publishing never waits on anyone.
+// One that falls out of the backlog skips ahead to a redraw of the newest
+// frame; one whose socket takes nothing for SPECTATOR_STALL is dropped.
+//
+// Like everything else in the server, channels belong to the event loop
+// thread, so the single writer and its readers need no locks.
+struct SpectatorFrame {
+    uint64_t sequence = 0;
+    GameView view;
+    std::string diff;   // From the previous frame
+    std::string redraw; // Clears the terminal first
+};
+
+using FramePtr = std::shared_ptr<const SpectatorFrame>;
+
+const char* tossFace(int toss) {
+    return (toss == 1) ? "Heads" : "Tails";
+}
+
+// One line on a finished turn: how the toss went and what came of it.
+void describeTurn(Screen& screen, const TurnRecord& turn, const GameView& view) {
+    if (turn.coinResult != 0) screen << (turn.coinCall == turn.coinResult ? "won the toss, " : "lost the toss, ");
+    if (turn.conquer && turn.defenseCall == 0) screen << "tried to conquer a square that was not the opponent's and forfeited";
+    else if (turn.conquer && turn.defenseToss == 0) screen << "is trying to conquer " << turn.square + 1;
+    else if (turn.conquer) screen << (turn.defenseCall == turn.defenseToss ? "failed to conquer " : "conquered ") << turn.square + 1;
+    else if (turn.square >= 0 && view.stage != GameView::Stage::Turn) screen << "placed on " << turn.square + 1;
+    else if (turn.square >= 0) screen << "is placing on " << turn.square + 1;
+    else screen << "forfeited";
+    screen << ".\n";
+}
+
+// What a spectator sees: the board, whose turn it is, the tosses so far
+// this turn and how the turn before went.
+void drawSpectatorView(Screen& screen, uint64_t session, bool againstAi, const GameView& view) {
+    const char* names[] = { "", "Blue Side", againstAi ? "The AI" : "Red Side" };
+    screen.clear();
+    screen.setColor(COLOR_YELLOW);
+    screen << " Watching game " << session << ": Blue Side vs " << (againstAi ? "the AI" : "Red Side") << "\n";
+    printBoard(screen, view.board);
+    if (view.stage == GameView::Stage::Rolling) {
+        screen << "The dice are deciding who goes first...\n";
+    }
+    else if (view.stage == GameView::Stage::Over) {
+        screen.setColor(view.winner == 1 ? COLOR_BLUE : view.winner == 2 ? COLOR_RED : COLOR_YELLOW);
+        if (view.winner == 0) screen << "THE BATTLE ENDS IN A DRAW!\n";
+        else screen << (view.winner == 1 ? "BLUE SIDE" : "RED SIDE") << " IS VICTORIOUS!\n";
+    }
+    else {
+        const TurnRecord& turn = view.turn;
+        screen.setColor(view.toMove == 1 ? COLOR_BLUE : COLOR_RED);
+        screen << names[view.toMove] << "'s turn. ";
+        screen.setColor(COLOR_WHITE);
+        if (turn.coinCall == 0) screen << "Calling the coin toss...";
+        else if (turn.coinResult == 0) screen << "Called " << tossFace(turn.coinCall) << ", the coin is in the air...";
+        else if (turn.coinCall == turn.coinResult) screen << "Called " << tossFace(turn.coinCall) << " and won: a POWER TURN.";
+        else screen << "Called " << tossFace(turn.coinCall) << ", it's " << tossFace(turn.coinResult) << ": a normal turn.";
+        screen << "\n";
+        if (view.stage == GameView::Stage::Defense && turn.square >= 0) {
+            screen.setColor(COLOR_YELLOW);
+            screen << "Conquering square " << turn.square + 1 << ". ";
+            if (turn.defenseCall == 0) screen << "The defender is about to call the toss...";
+            else if (turn.defenseToss == 0) screen << "The defender called " << tossFace(turn.defenseCall) << "...";
+            else if (turn.defenseCall == turn.defenseToss) screen << "Defense toss " << tossFace(turn.defenseToss) << ": the square is saved!";
+            else screen << "Defense toss " << tossFace(turn.defenseToss) << ": the square is conquered!";
+            screen << "\n";
+        }
+    }
+    if (view.lastMover != 0) {
+        screen.setColor(COLOR_GREY);
+        screen << "Last turn: " << names[view.lastMover] << " ";
+        describeTurn(screen, view.lastTurn, view);
+    }
+    screen.setColor(COLOR_WHITE);
+}
+
+class SpectatorChannel {
+public:
+    SpectatorChannel(uint64_t session, bool againstAi)
+        : session(session), againstAi(againstAi), diffs(ScreenTarget::Buffer), redraws(ScreenTarget::Buffer) {}
+
+    // Draws view and publishes it as the next frame, unless it looks the
+    // same as the last one. Returns whether it did.
+    bool publish(const GameView& view) {
+        drawSpectatorView(diffs, session, againstAi, view);
+        diffs.present();
+        std::string diff = diffs.takeOutput();
+        if (diff.empty()) return false;
+        drawSpectatorView(redraws, session, againstAi, view);
+        redraws.forgetTerminal();
+        redraws.present();
+        std::shared_ptr<SpectatorFrame> frame = std::make_shared<SpectatorFrame>();
+        frame->sequence = published;
+        frame->view = view;
+        frame->diff = std::move(diff);
+        frame->redraw = redraws.takeOutput();
+        ring[published % SPECTATOR_BACKLOG] = std::move(frame);
+        ++published;
+        return true;
+    }
+
+    uint64_t next() const { return published; } // Sequence of the next frame
+    // Frame sequence, or null once it has left the backlog.
+    FramePtr frame(uint64_t sequence) const {
+        if (sequence >= published || published - sequence > SPECTATOR_BACKLOG) return nullptr;
+        return ring[sequence % SPECTATOR_BACKLOG];
+    }
+    FramePtr newest() const { return frame(published - 1); }
+
+    void close() { closed = true; }
+    bool isClosed() const { return closed; }
+
+    std::vector<int> viewers; // Connection fds
+
+private:
+    uint64_t session;
+    bool againstAi;
+    Screen diffs;   // Keeps the frame before, to diff against
+    Screen redraws; // Forgets it every time
+    FramePtr ring[SPECTATOR_BACKLOG];
+    uint64_t published = 0;
+    bool closed = false; // The game is over; nothing more will be published
+};
+
+// A spectator's place in the channel it watches.
+struct Viewer {
+    std::shared_ptr<SpectatorChannel> channel; // Null until it picks a game
+    uint64_t seen = 0;                          // Sequence of the next frame it needs
+    bool drawn = false;                         // Has had a full redraw to apply diffs to
+    FramePtr sending;                           // Partway through, shared with the other viewers
+    const std::string* bytes = nullptr;         // Its diff or its redraw
+    size_t offset = 0;
+    bool stalled = false;                       // The socket has taken nothing...
+    Clock::time_point stalledSince;             // ...since then
+};
+
+// Sends bytes from offset on. False once the socket takes no more; a
+// failed socket counts as sent, and the next read reports it.
+bool sendSome(int fd, const std::string& bytes, size_t& offset) {
+    while (offset < bytes.size()) {
+        ssize_t sent = ::send(fd, bytes.data() + offset, bytes.size() - offset, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) return false;
+            offset = bytes.size();
+            break;
+        }
+        offset += static_cast<size_t>(sent);
+    }
+    return true;
+}
+
+// --- Server ---
+struct ServerOptions {
+    Endpoint endpoint;
+    int workers = 1;
+    int size = CLASSIC_SIZE;
+    int winLength = CLASSIC_SIZE;
+    uint64_t seed = 0;
+    double animationSpeed = 1.0;
+    uint64_t sessionLimit = 0; // Stop after this many sessions end; 0 = serve forever
+};
+
+struct Connection {
+    int fd = -1;
+    std::string in;                // Not yet a whole line
+    std::deque<std::string> lines; // Whole lines not yet used
+    std::string out;               // Not yet accepted by the socket
+    uint64_t session = 0;          // 0 until the client has an opponent
+    bool watchingWrites = false;
+    bool closing = false;          // Close once out is sent
+    bool pickingGame = false;      // Asked which game to watch
+    Viewer viewer;                 // Spectators only
+};
+
+struct Session {
+    Session(uint64_t id, const Board& board, uint64_t seed, const Strategy* ai, double speed)
+        : id(id), againstAi(ai != nullptr), screen(ScreenTarget::Buffer), rng(seed, id), game(screen, board, rng, ai, speed) {}
+
+    uint64_t id;
+    bool againstAi;
+    Screen screen;
+    Rng rng;
+    Game game;
+    std::shared_ptr<SpectatorChannel> channel; // Once someone watches
+    int players[2] = { -1, -1 };  // Connection fds; Red Side is -1 against the AI
+    bool thinking = false;        // A worker has the game
+    bool abandoned = false;       // Delete when the worker hands it back
+    bool progressed = false;      // Something happened since the last prompt was sent
+    uint64_t timerFor = 0;        // Animation the pending timer belongs to
+};
+
+struct TimerEntry {
+    Clock::time_point deadline;
+    uint64_t session;
+    uint64_t animation;
+    bool operator>(const TimerEntry& other) const { return deadline > other.deadline; }
+};
+
+// When a spectator that stalled is to be dropped, unless it has read since.
+struct StallCheck {
+    Clock::time_point deadline;
+    int fd;
+    bool operator>(const StallCheck& other) const { return deadline > other.deadline; }
+};
+
+class Server {
+public:
+    Server(const ServerOptions& options, const Strategy& ai)
+        : options(options), ai(ai), board(options.size, options.winLength) {}
+
+    int run();
+
+private:
+    void watch(int fd, uint32_t events, bool add);
+    void acceptClients();
+    void readClient(int fd);
+    void writeClient(Connection& connection);
+    bool feedViewer(Connection& connection);
+    void send(Connection& connection, const std::string& bytes);
+    void dropClient(int fd);
+
+    void chooseMode(Connection& connection);
+    void offerGames(Connection& connection);
+    void pickGame(Connection& connection, const std::string& line);
+    void broadcast(Session& session, bool ending);
+    void startSession(int blueFd, int redFd);
+    void pump(Session& session);
+    void flush(Session& session);
+    void endSession(Session& session, const char* message);
+    void runTimers();
+    void collectDecisions();
+
+    ServerOptions options;
+    const Strategy& ai;
+    Board board;
+    int epollFd = -1;
+    int listenFd = -1;
+    int notifyFd = -1;
+    std::unique_ptr<AiWorkers> workers;
+    std::unordered_map<int, Connection> connections;
+    std::unordered_map<uint64_t, std::unique_ptr<Session>> sessions;
+    std::priority_queue<TimerEntry, std::vector<TimerEntry>, std::greater<TimerEntry>> timers;
+    std::priority_queue<StallCheck, std::vector<StallCheck>, std::greater<StallCheck>> stallChecks;
+    int waitingFd = -1; // A client waiting for a human opponent
+    uint64_t nextSession = 1;
+    uint64_t sessionsEnded = 0;
+
+    // Spectator totals, for the report at exit
+    uint64_t spectators = 0;
+    uint64_t framesPublished = 0;
+    uint64_t framesSent = 0;
+    uint64_t redrawsSent = 0; // Of framesSent, to spectators who were new or had fallen behind
+    uint64_t spectatorsDropped = 0;
+};
+
+void Server::watch(int fd, uint32_t events, bool add) {
+    epoll_event event{};
+    event.events = events;
+    event.data.fd = fd;
+    epoll_ctl(epollFd, add ? EPOLL_CTL_ADD : EPOLL_CTL_MOD, fd, &event);
+}
+
+int Server::run() {
+    listenFd = openSocket(options.endpoint, true);
+    if (listenFd < 0) {
+        std::cout << "Could not listen: " << std::strerror(errno) << "\n";
+        return 1;
+    }
+    epollFd = epoll_create1(0);
+    notifyFd = eventfd(0, EFD_NONBLOCK);
+    watch(listenFd, EPOLLIN, true);
+    watch(notifyFd, EPOLLIN, true);
+    workers.reset(new AiWorkers(options.workers, notifyFd));
+
+    if (options.endpoint.unixPath.empty()) std::cout << "Serving EchoGrid on 127.0.0.1:" << options.endpoint.port;
+    else std::cout << "Serving EchoGrid on " << options.endpoint.unixPath;
+    std::cout << " with " << options.workers << " AI worker(s).\n" << std::flush;
+
+    std::vector<epoll_event> events(256);
+    while (options.sessionLimit == 0 || sessionsEnded < options.sessionLimit) {
+        int timeout = -1;
+        if (!timers.empty() || !stallChecks.empty()) {
+            Clock::time_point deadline = timers.empty() ? stallChecks.top().deadline
+                                       : stallChecks.empty() ? timers.top().deadline
+                                       : std::min(timers.top().deadline, stallChecks.top().deadline);
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - Clock::now());
+            timeout = std::max(0, static_cast<int>(wait.count()) + 1);
+        }
+        int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), timeout);
+        if (count < 0 && errno != EINTR) break;
+        for (int e = 0; e < count; ++e) {
+            int fd = events[e].data.fd;
+            if (fd == listenFd) {
+                acceptClients();
+            }
+            else if (fd == notifyFd) {
+                uint64_t ignored;
+                while (read(notifyFd, &ignored, sizeof(ignored)) > 0) {}
+                collectDecisions();
+            }
+            else {
+                if (events[e].events & EPOLLOUT) {
+                    auto it = connections.find(fd);
+                    if (it != connections.end()) writeClient(it->second);
+                }
+                if (events[e].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) readClient(fd);
+            }
+        }
+        runTimers();
+    }
+
+    workers.reset(); // Joins the pool before the sessions go away
+    for (auto& entry : connections) close(entry.first);
+    close(listenFd);
+    close(notifyFd);
+    close(epollFd);
+    if (!options.endpoint.unixPath.empty()) unlink(options.endpoint.unixPath.c_str());
+    std::cout << "Served " << sessionsEnded << " session(s)";
+    if (spectators > 0) {
+        std::cout << " to " << spectators << " spectator(s): " << framesPublished << " frames published, " << framesSent
+                  << " sent (" << redrawsSent << " as full redraws), " << spectatorsDropped << " spectator(s) dropped for stalling";
+    }
+    std::cout << ".\n";
+    return 0;
+}
+
+void Server::acceptClients() {
+    while (true) {
+        int fd = accept(listenFd, nullptr, nullptr);
+        if (fd < 0) return;
+        setNonBlocking(fd);
+        int on = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on)); // Fails harmlessly on Unix sockets
+        watch(fd, EPOLLIN, true);
+        Connection& connection = connections[fd];
+        connection = Connection();
+        connection.fd = fd;
+        send(connection, "\x1b[H\x1b[2J\x1b[93m EchoGrid\n\n\x1b[97m Choose your opponent:\n"
+                         " 1. Play against another Human\n 2. Play against the AI\n 3. Watch a game in progress\n"
+                         " Your choice: " + marker("menu"));
+    }
+}
+
+void Server::readClient(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    Connection& connection = it->second;
+    char chunk[4096];
+    while (true) {
+        ssize_t got = recv(fd, chunk, sizeof(chunk), 0);
+        if (got > 0) {
+            connection.in.append(chunk, static_cast<size_t>(got));
+            continue;
+        }
+        if (got < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        if (got < 0 && errno == EINTR) continue;
+        dropClient(fd); // Closed or failed
+        return;
+    }
+
+    size_t start = 0;
+    size_t end;
+    while ((end = connection.in.find('\n', start)) != std::string::npos) {
+        std::string line = connection.in.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        connection.lines.push_back(line);
+        start = end + 1;
+    }
+    connection.in.erase(0, start);
+
+    if (connection.viewer.channel) {
+        connection.lines.clear(); // Spectators have nothing to answer
+        return;
+    }
+    if (connection.session == 0) {
+        chooseMode(connection);
+        return;
+    }
+    auto session = sessions.find(connection.session);
+    if (session != sessions.end()) pump(*session->second);
+}
+
+void Server::send(Connection& connection, const std::string& bytes) {
+    connection.out += bytes;
+    writeClient(connection);
+}
+
+void Server::writeClient(Connection& connection) {
+    Viewer& viewer = connection.viewer;
+    size_t sent = 0;
+    bool open = sendSome(connection.fd, connection.out, sent);
+    connection.out.erase(0, sent);
+    if (sent > 0) viewer.stalled = false;
+    if (open && viewer.channel) {
+        open = feedViewer(connection); // Can queue the end of the stream in out
+        sent = 0;
+        if (open) open = sendSome(connection.fd, connection.out, sent);
+        connection.out.erase(0, sent);
+        if (sent > 0) viewer.stalled = false;
+    }
+    bool pending = !open;
+    if (pending && viewer.channel && !viewer.stalled) {
+        viewer.stalled = true;
+        viewer.stalledSince = Clock::now();
+        stallChecks.push({viewer.stalledSince + SPECTATOR_STALL, connection.fd});
+    }
+    if (pending != connection.watchingWrites) {
+        connection.watchingWrites = pending;
+        watch(connection.fd, pending ? (EPOLLIN | EPOLLOUT) : EPOLLIN, false);
+    }
+    if (!pending && connection.closing) {
+        int fd = connection.fd;
+        close(fd);
+        connections.erase(fd);
+    }
+}
+
+// Sends a spectator frames until it is caught up or its socket is full.
+// One whose next frame has left the backlog skips to a redraw of the
+// newest. Returns false if the socket is full. Once the game is over and
+// the spectator has every frame, queues the end of the stream; the channel
+// is kept until the connection closes, so the spectator can still be
+// dropped for stalling on it.
+bool Server::feedViewer(Connection& connection) {
+    Viewer& viewer = connection.viewer;
+    SpectatorChannel& channel = *viewer.channel;
+    while (true) {
+        if (!viewer.sending) {
+            if (viewer.seen == channel.next()) {
+                if (channel.isClosed() && !connection.closing) {
+                    connection.out += "\x1b[0m\n" + marker("end");
+                    connection.closing = true;
+                    std::vector<int>& viewers = channel.viewers;
+                    viewers.erase(std::remove(viewers.begin(), viewers.end(), connection.fd), viewers.end());
+                }
+                return true;
+            }
+            FramePtr frame = viewer.drawn ? channel.frame(viewer.seen) : nullptr;
+            if (frame) {
+                viewer.bytes = &frame->diff;
+            }
+            else {
+                frame = channel.newest();
+                viewer.bytes = &frame->redraw;
+                viewer.drawn = true;
+                ++redrawsSent;
+            }
+            viewer.sending = std::move(frame);
+            viewer.offset = 0;
+        }
+        size_t before = viewer.offset;
+        bool done = sendSome(connection.fd, *viewer.bytes, viewer.offset);
+        if (viewer.offset != before) viewer.stalled = false;
+        if (!done) return false;
+        viewer.seen = viewer.sending->sequence + 1;
+        viewer.sending.reset();
+        ++framesSent;
+    }
+}
+
+void Server::dropClient(int fd) {
+    auto it = connections.find(fd);
+    if (it == connections.end()) return;
+    if (it->second.viewer.channel) {
+        std::vector<int>& viewers = it->second.viewer.channel->viewers;
+        viewers.erase(std::remove(viewers.begin(), viewers.end(), fd), viewers.end());
+    }
+    uint64_t sessionId = it->second.session;
+    close(fd);
+    connections.erase(it);
+    if (waitingFd == fd) waitingFd = -1;
+
+    auto session = sessions.find(sessionId);
+    if (session == sessions.end()) return;
+    Session& left = *session->second;
+    for (int& player : left.players) {
+        if (player == fd) player = -1;
+    }
+    endSession(left, "\n\nYour opponent left the game.\n");
+}
+
+void Server::chooseMode(Connection& connection) {
+    while (!connection.lines.empty() && connection.session == 0 && connection.fd != waitingFd && !connection.viewer.channel) {
+        std::string line = connection.lines.front();
+        connection.lines.pop_front();
+        if (connection.pickingGame) {
+            pickGame(connection, line);
+            continue;
+        }
+        int mode = 0;
+        bool valid = parseNumber(line, mode) && (mode >= 1 && mode <= 3);
+        if (!valid) {
+            send(connection, "\x1b[2K\r Invalid choice. Please enter 1, 2 or 3: " + marker("menu"));
+        }
+        else if (mode == 3) {
+            offerGames(connection);
+        }
+        else if (mode == 2) {
+            startSession(connection.fd, -1);
+            return;
+        }
+        else if (waitingFd >= 0) {
+            startSession(waitingFd, connection.fd);
+            return;
+        }
+        else {
+            waitingFd = connection.fd;
+            send(connection, "\n Waiting for an opponent...\n" + marker("wait"));
+        }
+    }
+}
+
+void Server::offerGames(Connection& connection) {
+    std::vector<uint64_t> live;
+    for (const auto& entry : sessions) {
+        if (!entry.second->abandoned) live.push_back(entry.first);
+    }
+    if (live.empty()) {
+        send(connection, "\n No games are in progress right now.\n Your choice: " + marker("menu"));
+        return;
+    }
+    std::sort(live.begin(), live.end());
+    if (live.size() > GAMES_LISTED) live.erase(live.begin(), live.end() - GAMES_LISTED);
+    std::string list = "\n Games in progress:";
+    for (uint64_t id : live) list += " " + std::to_string(id);
+    connection.pickingGame = true;
+    send(connection, list + "\n Watch which one? (Enter for game " + std::to_string(live.back()) + "): " + marker("watch"));
+}
+
+// A game number, or an empty line for the newest game.
+void Server::pickGame(Connection& connection, const std::string& line) {
+    int number = 0;
+    auto chosen = sessions.end();
+    if (line.empty()) {
+        for (auto it = sessions.begin(); it != sessions.end(); ++it) {
+            if (!it->second->abandoned && (chosen == sessions.end() || it->first > chosen->first)) chosen = it;
+        }
+    }
+    else if (parseNumber(line, number) && number > 0) {
+        chosen = sessions.find(static_cast<uint64_t>(number));
+    }
+    if (chosen == sessions.end() || chosen->second->abandoned) {
+        connection.pickingGame = false;
+        send(connection, "\x1b[2K\r That game is not in progress.\n Your choice: " + marker("menu"));
+        return;
+    }
+
+    Session& session = *chosen->second;
+    if (!session.channel) session.channel = std::make_shared<SpectatorChannel>(session.id, session.againstAi);
+    connection.pickingGame = false;
+    connection.viewer = Viewer();
+    connection.viewer.channel = session.channel;
+    session.channel->viewers.push_back(connection.fd);
+    ++spectators;
+    broadcast(session, false); // Publishes the state as it is now, if it changed since the last frame
+    writeClient(connection);   // Sends it, or the last frame if that is the same
+}
+
+// Publishes the session's state to its spectators, if it has any, and sends
+// each what its socket will take; those whose sockets are full are sent the
+// rest when they drain. Ending closes the channel after the last frame.
+void Server::broadcast(Session& session, bool ending) {
+    std::shared_ptr<SpectatorChannel> channel = session.channel;
+    if (!channel) return;
+    if (!channel->viewers.empty() && channel->publish(session.game.view())) ++framesPublished;
+    if (ending) {
+        channel->close();
+        session.channel.reset();
+    }
+    std::vector<int> viewers = channel->viewers; // Feeding can close them
+    for (int fd : viewers) {
+        auto it = connections.find(fd);
+        if (it != connections.end() && !it->second.watchingWrites) writeClient(it->second);
+    }
+}
+
+void Server::startSession(int blueFd, int redFd) {
+    if (waitingFd == blueFd) waitingFd = -1;
+    uint64_t id = nextSession++;
+    const Strategy* opponent = (redFd < 0) ? &ai : nullptr;
+    std::unique_ptr<Session> created(new Session(id, board, options.seed, opponent, options.animationSpeed));
+    Session& session = *created;
+    sessions[id] = std::move(created);
+    session.players[0] = blueFd;
+    session.players[1] = redFd;
+    for (int p = 0; p < 2; ++p) {
+        if (session.players[p] < 0) continue;
+        Connection& connection = connections[session.players[p]];
+        connection.session = id;
+        connection.lines.clear(); // Anything typed at the menu was not meant for the game
+    }
+    session.game.start();
+    session.progressed = true;
+    pump(session);
+}
+
+// Feeds the session every event it can take now: queued lines, skipped
+// animations, and decisions. Stops at a timer, a worker, or an empty queue.
+void Server::pump(Session& session) {
+    METRICS_SCOPE(ServerPump);
+    Game& game = session.game;
+    while (!session.thinking) {
+        if (game.finished() || game.prompt() == Game::Prompt::Farewell) {
+            endSession(session, nullptr);
+            return;
+        }
+        if (game.thinking()) {
+            session.thinking = true;
+            workers->submit(session.id, &game);
+            break;
+        }
+
+        Connection* blue = (session.players[0] >= 0) ? &connections[session.players[0]] : nullptr;
+        Connection* red = (session.players[1] >= 0) ? &connections[session.players[1]] : nullptr;
+        if (game.animating()) {
+            // A line from either player skips it, as at the console; a bare
+            // Enter is used up doing so.
+            Connection* typist = (blue && !blue->lines.empty()) ? blue : (red && !red->lines.empty()) ? red : nullptr;
+            if (typist == nullptr) {
+                if (session.timerFor != game.animationNumber()) {
+                    session.timerFor = game.animationNumber();
+                    timers.push({Clock::now() + std::chrono::milliseconds(game.animationRemainingMs()), session.id, session.timerFor});
+                }
+                break;
+            }
+            if (typist->lines.front().empty()) typist->lines.pop_front();
+            game.onTimer();
+            session.progressed = true;
+            continue;
+        }
+
+        // Waiting for an answer: lines from the other player are out of turn.
+        int who = game.promptPlayer();
+        Connection* answering = nullptr;
+        if (who == 1 || (who == 0 && blue && !blue->lines.empty())) answering = blue;
+        else if (who == 2 || who == 0) answering = red;
+        Connection* other = (answering == blue) ? red : blue;
+        if (other && who != 0) other->lines.clear();
+        if (answering == nullptr || answering->lines.empty()) break;
+
+        std::string line = answering->lines.front();
+        answering->lines.pop_front();
+        game.onInput(line);
+        session.screen.forgetCursor(); // Only the typist's terminal echoed the line
+        session.progressed = true;
+    }
+    flush(session);
+}
+
+void Server::flush(Session& session) {
+    session.screen.present();
+    std::string frame = session.screen.takeOutput();
+    const char* kind = session.progressed ? promptKind(session.game.prompt()) : nullptr;
+    int who = session.game.promptPlayer();
+    session.progressed = false;
+    for (int p = 0; p < 2; ++p) {
+        if (session.players[p] < 0) continue;
+        std::string bytes = frame;
+        if (kind != nullptr && (who == 0 || who == p + 1)) bytes += marker(kind);
+        if (!bytes.empty()) send(connections[session.players[p]], bytes);
+    }
+    broadcast(session, false);
+}
+
+void Server::endSession(Session& session, const char* message) {
+    if (message != nullptr) {
+        session.screen.setColor(COLOR_YELLOW);
+        session.screen << message;
+    }
+    session.screen.present();
+    std::string frame = session.screen.takeOutput() + "\x1b[0m\n" + marker("end");
+    for (int& fd : session.players) {
+        if (fd < 0) continue;
+        Connection& connection = connections[fd];
+        connection.session = 0;
+        connection.closing = true;
+        send(connection, frame);
+        fd = -1;
+    }
+    broadcast(session, true);
+    ++sessionsEnded;
+    if (session.thinking) session.abandoned = true;
+    else sessions.erase(session.id);
+}
+
+void Server::runTimers() {
+    Clock::time_point now = Clock::now();
+    // Spectators whose sockets have taken nothing since they stalled, game over or not
+    while (!stallChecks.empty() && stallChecks.top().deadline <= now) {
+        int fd = stallChecks.top().fd;
+        stallChecks.pop();
+        auto it = connections.find(fd);
+        if (it == connections.end()) continue;
+        const Viewer& viewer = it->second.viewer;
+        if (viewer.channel && viewer.stalled && now - viewer.stalledSince >= SPECTATOR_STALL) {
+            ++spectatorsDropped;
+            dropClient(fd);
+        }
+    }
+    while (!timers.empty() && timers.top().deadline <= now) {
+        TimerEntry entry = timers.top();
+        timers.pop();
+        auto it = sessions.find(entry.session);
+        if (it == sessions.end()) continue;
+        Session& session = *it->second;
+        if (session.thinking || !session.game.animating() || session.game.animationNumber() != entry.animation) continue;
+        session.game.onTimer();
+        session.progressed = true;
+        pump(session);
+    }
+}
+
+void Server::collectDecisions() {
+    for (auto& result : workers->takeDone()) {
+        auto it = sessions.find(result.first);
+        if (it == sessions.end()) continue;
+        Session& session = *it->second;
+        session.thinking = false;
+        if (session.abandoned) {
+            sessions.erase(it);
+            continue;
+        }
+        session.game.onDecision(result.second);
+        session.progressed = true;
+        pump(session);
+    }
+}
+
+// --- Load Generator ---
+struct LoadClient {
+    int fd = -1;
+    std::string in;
+    Clock::time_point started;
+    Clock::time_point answered;
+    bool awaiting = false; // An answer is out and its reply not yet in
+    int nextSquare = 0;
+    bool spectator = false;
+    bool asked = false;    // A spectator has asked to watch once
+    bool retrying = false; // Waiting until retryAt to ask again
+    Clock::time_point retryAt;
+};
+
+struct LoadStats {
+    uint64_t sessions = 0;
+    uint64_t failed = 0;
+    std::vector<double> latencies; // Microseconds
+    uint64_t watched = 0;          // Games spectators saw to the end
+    uint64_t spectatorBytes = 0;
+};
+
+// Answers a prompt the way a simple player would: always call heads, always
+// place, and try squares in turn until the server accepts one.
+std::string answer(const std::string& kind, LoadClient& client, int cells, Rng& rng) {
+    if (client.spectator) return (kind == "menu") ? "3" : ""; // The newest game
+    if (kind == "menu") return "2";
+    if (kind == "call" || kind == "defense") return std::to_string(1 + rng.below(2));
+    if (kind == "action") return "1";
+    if (kind == "place" || kind == "conquer") {
+        client.nextSquare = (client.nextSquare % cells) + 1;
+        return std::to_string(client.nextSquare);
+    }
+    return ""; // start
+}
+
+// Spectators watch the newest game, and the next one when it ends, until
+// the last player is done. One offered the menu again, because no game was
+// in progress or the newest ended first, waits SPECTATOR_RETRY before
+// asking again rather than keeping the server busy with menus.
+int runLoad(const Endpoint& endpoint, uint64_t sessionCount, int concurrency, int spectators, int size, uint64_t seed) {
+    int epollFd = epoll_create1(0);
+    std::unordered_map<int, LoadClient> clients;
+    LoadStats stats;
+    Rng rng(seed);
+    uint64_t launched = 0;
+    int playing = 0; // Clients that are not spectators
+    int cells = size * size;
+    std::deque<std::pair<Clock::time_point, int>> retries; // Spectators to ask again, soonest first
+
+    auto launch = [&](bool spectator) {
+        int fd = openSocket(endpoint, false);
+        if (!spectator) ++launched;
+        if (fd < 0) {
+            ++stats.failed;
+            return;
+        }
+        if (!spectator) ++playing;
+        LoadClient& client = clients[fd];
+        client = LoadClient();
+        client.fd = fd;
+        client.spectator = spectator;
+        client.started = Clock::now();
+        client.nextSquare = static_cast<int>(rng.below(static_cast<uint32_t>(cells)));
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = fd;
+        epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event);
+    };
+    auto finish = [&](int fd, bool ok) {
+        bool spectator = clients[fd].spectator;
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        clients.erase(fd);
+        if (spectator) {
+            if (ok) ++stats.watched;
+            else ++stats.failed;
+            if (playing > 0) launch(true);
+            return;
+        }
+        --playing;
+        if (ok) ++stats.sessions;
+        else ++stats.failed;
+        if (launched < sessionCount) launch(false);
+    };
+
+    Clock::time_point begin = Clock::now();
+    while (launched < sessionCount && playing < concurrency) launch(false);
+    for (int s = 0; s < spectators; ++s) launch(true);
+
+    std::vector<epoll_event> events(256);
+    while (playing > 0) {
+        int timeout = 10000;
+        if (!retries.empty()) {
+            auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(retries.front().first - Clock::now());
+            timeout = std::max(0, static_cast<int>(wait.count()) + 1);
+        }
+        int count = epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), timeout);
+        if (count == 0 && retries.empty()) {
+            std::cout << "The server stopped answering.\n";
+            break;
+        }
+        Clock::time_point now = Clock::now();
+        while (!retries.empty() && retries.front().first <= now) {
+            auto due = retries.front();
+            retries.pop_front();
+            auto it = clients.find(due.second);
+            if (it == clients.end() || !it->second.retrying || it->second.retryAt != due.first) continue;
+            it->second.retrying = false;
+            if (::send(it->first, "3\n", 2, MSG_NOSIGNAL) < 0) finish(it->first, false);
+        }
+        for (int e = 0; e < count; ++e) {
+            int fd = events[e].data.fd;
+            auto it = clients.find(fd);
+            if (it == clients.end()) continue;
+            LoadClient& client = it->second;
+            char chunk[8192];
+            ssize_t got;
+            bool closed = false;
+            while ((got = recv(fd, chunk, sizeof(chunk), 0)) > 0) {
+                client.in.append(chunk, static_cast<size_t>(got));
+                if (client.spectator) stats.spectatorBytes += static_cast<uint64_t>(got);
+            }
+            if (got == 0 || (got < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) closed = true;
+
+            bool ended = false;
+            std::string reply;
+            size_t at;
+            while ((at = client.in.find(MARKER_START)) != std::string::npos) {
+                size_t stop = client.in.find(MARKER_END, at);
+                if (stop == std::string::npos) break;
+                size_t kindAt = at + std::strlen(MARKER_START);
+                std::string kind = client.in.substr(kindAt, stop - kindAt);
+                client.in.erase(0, stop + 1);
+                if (client.awaiting) {
+                    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - client.answered);
+                    stats.latencies.push_back(elapsed.count() / 1000.0);
+                    client.awaiting = false;
+                }
+                if (kind == "end") {
+                    ended = true;
+                }
+                else if (client.spectator && kind == "menu" && client.asked) {
+                    client.retrying = true;
+                    client.retryAt = Clock::now() + SPECTATOR_RETRY;
+                    retries.push_back({client.retryAt, fd});
+                }
+                else if (kind != "wait") {
+                    if (client.spectator && kind == "menu") client.asked = true;
+                    reply += answer(kind, client, cells, rng) + "\n";
+                }
+            }
+            if (ended) {
+                finish(fd, true);
+                continue;
+            }
+            // A spectator's frames have no markers; keep only what could be the start of one
+            size_t keep = std::strlen(MARKER_START);
+            if (client.spectator && client.in.find(MARKER_START) == std::string::npos && client.in.size() > keep) {
+                client.in.erase(0, client.in.size() - keep);
+            }
+            if (!reply.empty()) {
+                client.answered = Clock::now();
+                client.awaiting = !client.spectator;
+                if (::send(fd, reply.data(), reply.size(), MSG_NOSIGNAL) < 0) closed = true;
+            }
+            if (closed) finish(fd, false);
+        }
+    }
+    for (auto& entry : clients) close(entry.first); // Spectators still watching
+    close(epollFd);
+
+    double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+    std::vector<double>& latencies = stats.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&](double p) {
+        if (latencies.empty()) return 0.0;
+        size_t index = static_cast<size_t>(p * (latencies.size() - 1) + 0.5);
+        return latencies[index];
+    };
+    std::cout << std::fixed << std::setprecision(1)
+              << stats.sessions << " session(s) in " << seconds << " s: "
+              << stats.sessions / seconds << " sessions/s with " << concurrency << " at a time, "
+              << stats.failed << " failed\n"
+              << latencies.size() << " answers, latency p50 " << percentile(0.50) << " us, p99 "
+              << percentile(0.99) << " us, max " << (latencies.empty() ? 0.0 : latencies.back()) << " us\n";
+    if (spectators > 0) {
+        std::cout << spectators << " spectator(s) watched " << stats.watched << " game(s) to the end and received "
+                  << stats.spectatorBytes / 1024.0 << " KB\n";
+    }
+    return stats.failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int serveCommand(int argc, char* argv[]) {
+    ServerOptions options;
+    options.seed = randomSeed();
+    options.workers = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    std::string aiName = "heuristic";
+    MctsOptions mcts;
+    std::string metricsPath;
+    std::string tracePath;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        bool valid = true;
+        if (arg == "--serve") continue;
+        else if (parseEndpoint(arg, i, argc, argv, options.endpoint, valid)) {}
+        else if (arg == "--workers" && hasValue) valid = parseNumber(argv[++i], options.workers);
+        else if (arg == "--size" && hasValue) valid = parseNumber(argv[++i], options.size);
+        else if (arg == "--win" && hasValue) valid = parseNumber(argv[++i], options.winLength);
+        else if (arg == "--ai" && hasValue) aiName = argv[++i];
+        else if (arg == "--ai-ms" && hasValue) valid = parseNumber(argv[++i], mcts.thinkMs);
+        else if (arg == "--ai-playouts" && hasValue) valid = parseNumber(argv[++i], mcts.maxPlayouts);
+        else if (arg == "--seed" && hasValue) valid = parseNumber(argv[++i], options.seed);
+        else if (arg == "--speed" && hasValue) valid = parseNumber(argv[++i], options.animationSpeed);
+        else if (arg == "--fast") options.animationSpeed = 0.0;
+        else if (arg == "--sessions" && hasValue) valid = parseNumber(argv[++i], options.sessionLimit);
+        else if (arg == "--metrics" && hasValue) metricsPath = argv[++i];
+        else if (arg == "--trace" && hasValue) tracePath = argv[++i];
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n" << SERVE_USAGE;
+            return 1;
+        }
+        if (!valid) {
+            std::cout << "Invalid value '" << argv[i] << "' for " << arg << ".\n" << SERVE_USAGE;
+            return 1;
+        }
+    }
+    if (options.workers < 1) options.workers = 1;
+    if (options.animationSpeed < 0.0) options.animationSpeed = 0.0;
+    if (!isValidGeometry(options.size, options.winLength)) {
+        std::cout << "Board size must be " << MIN_BOARD_SIZE << "-" << MAX_BOARD_SIZE
+                  << " and the win length 3 up to the board size.\n";
+        return 1;
+    }
+
+    PolicyTable policy;
+    if (aiName == "solved") {
+        bool classic = (options.size == CLASSIC_SIZE && options.winLength == CLASSIC_SIZE);
+        if (!classic || !policy.load(POLICY_FILE)) aiName = "heuristic";
+    }
+    std::unique_ptr<Strategy> ai = makeStrategy(aiName, policy, mcts);
+    if (!ai) {
+        std::cout << "Unknown AI '" << aiName << "'. Choose heuristic, random, solved or mcts.\n";
+        return 1;
+    }
+
+    if ((!metricsPath.empty() || !tracePath.empty()) && !enableMetrics(!tracePath.empty())) {
+        std::cout << "This build has no metrics (ECHOGRID_METRICS=0).\n";
+        return 1;
+    }
+
+    signal(SIGPIPE, SIG_IGN);
+    Server server(options, *ai);
+    int result = server.run();
+    if (result == 0 && metricsEnabled()) {
+        printMetrics(std::cout);
+        std::string error;
+        if (!saveMetrics(metricsPath, tracePath, error)) {
+            std::cout << "Could not save metrics: " << error << ".\n";
+            return 1;
+        }
+    }
+    return result;
+}
+
+int loadCommand(int argc, char* argv[]) {
+    Endpoint endpoint;
+    uint64_t sessions = 1000;
+    int concurrency = 64;
+    int spectators = 0;
+    int size = CLASSIC_SIZE;
+    uint64_t seed = randomSeed();
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        bool valid = true;
+        if (arg == "--load") continue;
+        else if (parseEndpoint(arg, i, argc, argv, endpoint, valid)) {}
+        else if (arg == "--sessions" && hasValue) valid = parseNumber(argv[++i], sessions);
+        else if (arg == "--concurrency" && hasValue) valid = parseNumber(argv[++i], concurrency);
+        else if (arg == "--spectators" && hasValue) valid = parseNumber(argv[++i], spectators);
+        else if (arg == "--size" && hasValue) valid = parseNumber(argv[++i], size);
+        else if (arg == "--seed" && hasValue) valid = parseNumber(argv[++i], seed);
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n" << LOAD_USAGE;
+            return 1;
+        }
+        if (!valid) {
+            std::cout << "Invalid value '" << argv[i] << "' for " << arg << ".\n" << LOAD_USAGE;
+            return 1;
+        }
+    }
+    if (concurrency < 1) concurrency = 1;
+    if (spectators < 0) spectators = 0;
+    if (size < MIN_BOARD_SIZE || size > MAX_BOARD_SIZE) size = CLASSIC_SIZE;
+    signal(SIGPIPE, SIG_IGN);
+    return runLoad(endpoint, sessions, concurrency, spectators, size, seed);
+}
+
+#else
+
+int serveCommand(int, char*[]) {
+    std::cout << "The game server needs Linux (it is built on epoll).\n";
+    return 1;
+}
+
+int loadCommand(int, char*[]) {
+    std::cout << "The load generator needs Linux (it is built on epoll).\n";
+    return 1;
+}
+
+#endif
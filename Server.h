@@ -0,0 +1,41 @@
+#pragma once
+
+// --- Game Server ---
+// Hosts many games in one process: a single epoll loop owns every socket,
+// session and animation timer, and AI turns run on a worker pool so a slow
+// search never stalls anyone else's I/O. Each session is the same Game
+// state machine the console plays, fed by socket lines instead of stdin.
+// Linux only.
+//
+// Protocol, over TCP or a Unix domain socket:
+//  - Client to server: one line per answer, exactly what a player would
+//    type at the console ("2", "5", or an empty line for Enter).
+//  - Server to client: the game as ANSI frames, the same diffs the console
+//    gets, so any terminal client (nc, socat, telnet) can play. Whenever
+//    the server waits for this client it ends the output with a marker
+//    terminals ignore, ESC ] echogrid;KIND BEL, where KIND is menu, start,
+//    call, action, place, conquer or defense. "wait" means the client is
+//    queued for an opponent. "end" follows the last frame, then the server
+//    closes the connection.
+//
+// A new client chooses 1 (another human: paired with the next client that
+// does the same), 2 (the AI) or 3 (watch). A spectator is offered the games
+// in progress ("watch" marker) and answers with a game number, or an empty
+// line for the newest. From then on it only receives frames: the board,
+// whose turn it is and how the tosses went, then "end" when the game ends.
+// Every spectator of a game is sent the same bytes, drawn once per change;
+// one that cannot keep up skips ahead to the latest frame rather than
+// holding anything up, and one that stops reading is dropped.
+
+// Entry point for "EchoGrid --serve [--port P | --unix PATH] [--workers N] [--size N] [--win K]
+// [--ai NAME] [--ai-ms MS] [--ai-playouts P] [--seed S] [--speed F | --fast] [--sessions N]
+// [--metrics FILE] [--trace FILE]". The metrics are written once the server
+// stops, so they need --sessions.
+int serveCommand(int argc, char* argv[]);
+
+// Entry point for "EchoGrid --load [--port P | --unix PATH] [--sessions N] [--concurrency C]
+// [--spectators W] [--size N] [--seed S]": plays N games against the
+// server's AI with C scripted clients at a time and reports sessions per
+// second and the latency from each answer to the server's next prompt. W
+// more clients watch the newest game meanwhile.
+int loadCommand(int argc, char* argv[]);
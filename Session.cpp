@@ -0,0 +1,187 @@
+#include "Session.h"
+#include <memory>
+#include <sstream>
+#include "Board.h"
+#include "Game.h"
+#include "Hints.h"
+#include "Metrics.h"
+#include "Policy.h"
+#include "Rng.h"
+#include "Simulation.h"
+
+namespace {
+
+void printTitle(Screen& screen) {
+    screen.clear();
+    screen.setColor(COLOR_YELLOW);
+    screen << R"(
+  _______ ______ _    _  _____   ______ _____ __   __ ______ 
+ |__   __|  ____| |  | |/ ____| |  ____/ ____|  \ |  |  ____|
+    | |  | |__  | |__| | |  __  | |__ | |  __| \ \|  | |__   
+    | |  |  __| |  __  | | |_ | |  __|| | |_ | |\   |  __|  
+    | |  | |____| |  | | |__| | | |___| |__| | | \  | |____ 
+    |_|  |______|_|  |_|\_____| |______\_____|_|  \_|______|
+                                                          
+)" << '\n';
+}
+
+std::string winLengthName(int winLength) {
+    const char* names[] = { "three", "four", "five" };
+    return (winLength >= 3 && winLength <= 5) ? names[winLength - 3] : std::to_string(winLength);
+}
+
+// Shows the frame so far and reads one line where the cursor was left.
+// Returns false once input ends.
+bool readLine(Screen& screen, InputSource& input, std::string& line) {
+    screen.present();
+    bool answered;
+    {
+        METRICS_SCOPE(InputWait);
+        answered = input.waitForLine(-1);
+    }
+    if (!answered) return false;
+    line = input.takeLine();
+    screen.echoInput(line);
+    return true;
+}
+
+} // namespace
+
+bool parseSessionOptions(const std::vector<std::string>& args, SessionOptions& options, std::string& error) {
+    bool fast = false;
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        bool hasValue = (i + 1 < args.size());
+        bool valid = true;
+        double tableMb = 0.0;
+        if (arg == "--fast") fast = true;
+        else if (arg == "--hints") options.showHints = true;
+        else if (arg == "--seed" && hasValue) valid = parseNumber(args[++i], options.seed);
+        else if (arg == "--size" && hasValue) valid = parseNumber(args[++i], options.size);
+        else if (arg == "--win" && hasValue) valid = parseNumber(args[++i], options.winLength);
+        else if (arg == "--ai" && hasValue) options.aiName = args[++i];
+        else if (arg == "--ai-ms" && hasValue) valid = parseNumber(args[++i], options.mcts.thinkMs);
+        else if (arg == "--ai-threads" && hasValue) valid = parseNumber(args[++i], options.mcts.threads);
+        else if (arg == "--ai-playouts" && hasValue) valid = parseNumber(args[++i], options.mcts.maxPlayouts);
+        else if (arg == "--tt-mb" && hasValue) {
+            valid = parseNumber(args[++i], tableMb) && tableMb >= 0.0;
+            options.mcts.tableBytes = static_cast<size_t>(tableMb * (1 << 20));
+        }
+        else if (arg == "--speed" && hasValue) valid = parseNumber(args[++i], options.animationSpeed);
+        else {
+            error = "Unknown option '" + arg + "'.";
+            return false;
+        }
+        if (!valid) {
+            error = "Invalid value '" + args[i] + "' for " + arg + ".";
+            return false;
+        }
+    }
+    if (fast) options.animationSpeed = 0.0;
+    if (!isValidGeometry(options.size, options.winLength)) {
+        error = "Board size must be " + std::to_string(MIN_BOARD_SIZE) + "-" + std::to_string(MAX_BOARD_SIZE)
+              + " and the win length 3 up to the board size.";
+        return false;
+    }
+    const std::string& ai = options.aiName;
+    if (ai != "auto" && ai != "heuristic" && ai != "random" && ai != "solved" && ai != "mcts") {
+        error = "Unknown AI '" + ai + "'. Choose auto, heuristic, random, solved or mcts.";
+        return false;
+    }
+    if (options.mcts.threads < 1) options.mcts.threads = 1;
+    if (options.animationSpeed < 0.0) options.animationSpeed = 0.0;
+    return true;
+}
+
+std::string formatSessionOptions(const SessionOptions& options) {
+    std::ostringstream out;
+    out << "--seed " << options.seed << " --size " << options.size << " --win " << options.winLength
+        << " --ai " << options.aiName;
+    if (options.aiName == "mcts") {
+        out << " --ai-ms " << options.mcts.thinkMs << " --ai-threads " << options.mcts.threads
+            << " --ai-playouts " << options.mcts.maxPlayouts
+            << " --tt-mb " << static_cast<double>(options.mcts.tableBytes) / (1 << 20);
+    }
+    if (options.animationSpeed == 0.0) out << " --fast";
+    else if (options.animationSpeed != 1.0) out << " --speed " << options.animationSpeed;
+    if (options.showHints) out << " --hints";
+    return out.str();
+}
+
+bool playSession(const SessionOptions& options, Screen& screen, InputSource& input, GameRecord* record) {
+    Rng rng(options.seed);
+    Board board(options.size, options.winLength);
+    PolicyTable policy;
+    std::unique_ptr<Strategy> ai;
+    std::string line;
+
+    printTitle(screen);
+    screen.setColor(COLOR_WHITE);
+
+    // --- Game Mode Selection ---
+    screen << "\n\n Choose your opponent:\n";
+    screen << " 1. Play against another Human\n";
+    screen << " 2. Play against the AI\n";
+    screen << " Your choice: ";
+    int gameMode = 0;
+    while (true) {
+        if (!readLine(screen, input, line)) return false;
+        if (parseNumber(line, gameMode) && (gameMode == 1 || gameMode == 2)) break;
+        screen << "Invalid choice. Please enter 1 or 2: ";
+    }
+    if (gameMode == 2) {
+        std::string aiName = options.aiName;
+        bool wantsTable = (aiName == "auto" || aiName == "solved");
+        if (wantsTable && isClassicBoard(board) && !policy.load(POLICY_FILE)) {
+            screen.setColor(COLOR_GREY);
+            screen << "\n (AI policy table '" << POLICY_FILE << "' not found, the AI will play by instinct.)\n";
+            screen.setColor(COLOR_WHITE);
+        }
+        if (wantsTable) aiName = policy.isLoaded() ? "solved" : "heuristic";
+        ai = makeStrategy(aiName, policy, options.mcts);
+    }
+    if (options.showHints && isClassicBoard(board) && !policy.isLoaded()) policy.load(POLICY_FILE); // Else the hints estimate
+    HintEvaluator hints(&policy);
+
+    screen << "\n Welcome to the EchoGrid. Where every move can echo into victory... or defeat.\n";
+    screen << " The rules are different here. Victory requires luck, guts, and strategy.\n\n";
+    screen << " Press Enter to see the rules...";
+    if (!readLine(screen, input, line)) return false;
+
+    // --- Rule Explanation ---
+    screen.clear();
+    screen.setColor(COLOR_YELLOW);
+    screen << "================================ R U L E S ================================\n\n";
+    screen.setColor(COLOR_WHITE);
+    screen << " 1. To start, both players roll a die. Highest roller goes first.\n\n";
+    screen << " 2. On your turn, you toss a coin. Winning grants you a POWER TURN.\n";
+    screen << "    - POWER TURN: You can [Place] on an empty square OR try to [Conquer]\n";
+    screen << "      an opponent's square.\n";
+    screen << "    - NORMAL TURN: You can only [Place] on an empty square.\n\n";
+    screen.setColor(COLOR_GREEN);
+    screen << " >> CONQUER RULE: When you attempt to conquer, the defender gets a\n";
+    screen << " >>               'Defense Toss'. If they win the toss, they keep their\n";
+    screen << " >>               space and your turn ends! If they lose, you take it.\n\n";
+    screen.setColor(COLOR_RED);
+    screen << " >> WARNING: Attempting to Conquer an invalid square (empty or your own)\n";
+    screen << " >>          results in forfeiting your turn!\n\n";
+    screen.setColor(COLOR_WHITE);
+    screen << " 3. The first player to get " << winLengthName(board.winLength) << " in a row wins!\n\n";
+    screen << " 4. Changed your mind? Answer the coin call with u to take back your\n";
+    screen << "    last turn and " << (ai ? "the AI's" : "your opponent's") << " reply.\n\n";
+    screen.setColor(COLOR_YELLOW);
+    screen << "===========================================================================\n\n";
+    screen << "Press Enter to begin...";
+    if (!readLine(screen, input, line)) return false;
+
+    // --- The Game ---
+    Game game(screen, board, rng, ai.get(), options.animationSpeed);
+    if (record != nullptr) {
+        record->begin(options.seed, 0, options.size, options.winLength);
+        game.setRecord(record);
+    }
+    if (options.showHints) game.setHints(&hints);
+    game.setUndo(true);
+    runGame(game, input, screen);
+    return game.finished();
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "GameRecord.h"
+#include "Input.h"
+#include "Mcts.h"
+#include "Screen.h"
+
+// --- Interactive Session ---
+// What "EchoGrid" does at a terminal: the title, the choice of opponent, the
+// rules and one game. The caller decides where the answers come from and
+// where the frames go, so a session script replays exactly what a player
+// typed, with the same seed, and gets the same frames back.
+
+struct SessionOptions {
+    uint64_t seed = 0;
+    int size = CLASSIC_SIZE;
+    int winLength = CLASSIC_SIZE;
+    std::string aiName = "auto"; // The solved table on 3x3, the heuristic elsewhere
+    MctsOptions mcts;
+    double animationSpeed = 1.0; // "--speed 2" halves every pause, "--fast" skips them
+    bool showHints = false;      // "--hints" shows every action's value beside the board
+};
+
+// Reads "--seed S", "--size N", "--win K", "--ai NAME", "--ai-ms MS",
+// "--ai-threads T", "--ai-playouts P", "--tt-mb MB", "--speed X", "--fast"
+// and "--hints" from args into options. Returns false, with a message for
+// the player in error, for any other argument, a value that is not a
+// number, an impossible board or an unknown AI.
+bool parseSessionOptions(const std::vector<std::string>& args, SessionOptions& options, std::string& error);
+
+// The options as arguments parseSessionOptions reads back the same, the
+// seed included.
+std::string formatSessionOptions(const SessionOptions& options);
+
+// Plays one session. If record is given it is begun with the seed and holds
+// the game once it ends. Returns false if input ended first.
+bool playSession(const SessionOptions& options, Screen& screen, InputSource& input, GameRecord* record = nullptr);
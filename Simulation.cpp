@@ -0,0 +1,447 @@
+#include "Simulation.h"
+#include "Metrics.h"
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "Input.h"
+
+// --- Strategies ---
+namespace {
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+class HeuristicStrategy : public StrategyFor<HeuristicStrategy> {
+public:
+    const char* name() const override { return "heuristic"; }
+    template <typename BoardType>
+    TurnAction choose(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng) const {
+        return chooseHeuristicAction(board, playerSymbol, powerTurn, rng);
+    }
+};
+
+// Uniformly random legal play. On a power turn it conquers half the time
+// when there is anything to conquer.
+class RandomStrategy : public StrategyFor<RandomStrategy> {
+public:
+    const char* name() const override { return "random"; }
+    template <typename BoardType>
+    TurnAction choose(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng) const {
+        TurnAction action;
+        char opponentSymbol = (playerSymbol == P1_SYMBOL) ? P2_SYMBOL : P1_SYMBOL;
+        int empty[MAX_CELLS];
+        int opponent[MAX_CELLS];
+        int emptyCount = 0;
+        int opponentCount = 0;
+        for (int i = 0; i < cellCount(board); ++i) {
+            char cell = cellSymbol(board, i);
+            if (cell == '\0') empty[emptyCount++] = i;
+            else if (cell == opponentSymbol) opponent[opponentCount++] = i;
+        }
+        if (powerTurn && opponentCount > 0 && rng.below(2) == 0) {
+            action.conquer = true;
+            action.square = opponent[rng.below(opponentCount)];
+        }
+        else {
+            action.square = empty[rng.below(emptyCount)];
+        }
+        return action;
+    }
+};
+
+class SolvedStrategy : public StrategyFor<SolvedStrategy> {
+public:
+    explicit SolvedStrategy(const PolicyTable& policy) : policy(policy) {}
+    const char* name() const override { return "solved"; }
+    template <typename BoardType>
+    TurnAction choose(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng) const {
+        return chooseSolvedAction(board, playerSymbol, powerTurn, policy, rng);
+    }
+
+private:
+    const PolicyTable& policy;
+};
+
+// Searches every move. Totals are shared by all simulation threads and only
+// touched once per move, so a mutex is cheap enough.
+class MctsStrategy : public StrategyFor<MctsStrategy> {
+public:
+    explicit MctsStrategy(const MctsOptions& options) : options(options) {}
+    const char* name() const override { return "mcts"; }
+    template <typename BoardType>
+    TurnAction choose(const BoardType& board, char playerSymbol, bool powerTurn, Rng& rng) const {
+        MctsReport report;
+        TurnAction action = searchMcts(board, playerSymbol, powerTurn, options, rng, &report);
+        std::lock_guard<std::mutex> lock(totalsMutex);
+        ++searches;
+        playouts += report.playouts;
+        seconds += report.seconds;
+        table.merge(report.table);
+        return action;
+    }
+
+    std::string summary() const override {
+        std::lock_guard<std::mutex> lock(totalsMutex);
+        std::ostringstream out;
+        out << std::fixed << std::setprecision(0) << playouts << " playouts over " << searches << " searches, "
+            << (seconds > 0 ? playouts / seconds : 0.0) << " playouts/s with " << options.threads << " search thread(s)";
+        if (options.tableBytes > 0) {
+            out << std::setprecision(1) << "; table " << percent(table.hits, table.probes) << "% hits, "
+                << table.collisions << " collisions, " << table.replacements << " replacements";
+        }
+        return out.str();
+    }
+
+private:
+    MctsOptions options;
+    mutable std::mutex totalsMutex;
+    mutable uint64_t searches = 0;
+    mutable uint64_t playouts = 0;
+    mutable double seconds = 0.0;
+    mutable TableCounters table;
+};
+
+} // namespace
+
+std::unique_ptr<Strategy> makeStrategy(const std::string& name, const PolicyTable& policy, const MctsOptions& mcts) {
+    if (name == "heuristic") return std::unique_ptr<Strategy>(new HeuristicStrategy());
+    if (name == "random") return std::unique_ptr<Strategy>(new RandomStrategy());
+    if (name == "solved" && policy.isLoaded()) return std::unique_ptr<Strategy>(new SolvedStrategy(policy));
+    if (name == "mcts") return std::unique_ptr<Strategy>(new MctsStrategy(mcts));
+    return nullptr;
+}
+
+// --- Game Engine ---
+template <typename BoardType>
+GameOutcome playGame(const Strategy& blue, const Strategy& red, BoardType board, Rng& rng, GameRecord* record) {
+    METRICS_SCOPE(Game);
+    GameOutcome outcome;
+
+    int p1_roll, p2_roll;
+    do {
+        p1_roll = rng.roll(6);
+        p2_roll = rng.roll(6);
+    } while (p1_roll == p2_roll);
+    board.toMove = (p1_roll > p2_roll) ? 1 : 2;
+    outcome.firstPlayer = board.toMove;
+    if (record) {
+        record->blueRoll = static_cast<uint8_t>(p1_roll);
+        record->redRoll = static_cast<uint8_t>(p2_roll);
+    }
+
+    while (true) {
+        int player = board.toMove;
+        char symbol = (player == 1) ? P1_SYMBOL : P2_SYMBOL;
+        char opponentSymbol = (player == 1) ? P2_SYMBOL : P1_SYMBOL;
+        const Strategy& strategy = (player == 1) ? blue : red;
+        ++outcome.turns;
+
+        int coinCall = rng.roll(2);
+        int coinResult = rng.roll(2);
+        bool powerTurn = (coinCall == coinResult);
+
+        TurnAction action;
+        {
+            METRICS_SCOPE(AiThink);
+            action = strategy.chooseAction(board, symbol, powerTurn, rng);
+        }
+        TurnRecord turn;
+        turn.coinCall = static_cast<uint8_t>(coinCall);
+        turn.coinResult = static_cast<uint8_t>(coinResult);
+        turn.conquer = action.conquer && powerTurn;
+        turn.square = static_cast<int16_t>(action.square);
+        int claimedSquare = -1;
+        if (action.conquer && powerTurn) {
+            ++outcome.conquerAttempts[player];
+            if (action.square >= 0 && cellSymbol(board, action.square) == opponentSymbol) {
+                int defenseCall = rng.roll(2);
+                int defenseToss = rng.roll(2);
+                turn.defenseCall = static_cast<uint8_t>(defenseCall);
+                turn.defenseToss = static_cast<uint8_t>(defenseToss);
+                if (defenseCall != defenseToss) {
+                    setCell(board, action.square, symbol);
+                    claimedSquare = action.square;
+                    ++outcome.conquerSuccesses[player];
+                }
+                else {
+                    METRICS_COUNT(DefenseSaves);
+                }
+            }
+            else {
+                ++outcome.forfeits[player]; // Conquering an empty or own square
+            }
+        }
+        else if (!action.conquer && action.square >= 0 && isEmptySquare(board, action.square)) {
+            setCell(board, action.square, symbol);
+            claimedSquare = action.square;
+        }
+        else {
+            ++outcome.forfeits[player];
+        }
+        if (record) record->turns.push_back(turn);
+
+        bool won, drawn;
+        {
+            METRICS_SCOPE(RuleCheck);
+            // Only a line through the square just claimed can have been completed
+            won = checkWinAt(board, claimedSquare, symbol);
+            drawn = !won && checkDraw(board);
+        }
+        if (won || drawn) {
+            outcome.winner = won ? player : 0;
+            break;
+        }
+        board.toMove = (player == 1) ? 2 : 1;
+    }
+    if (record) record->finish(board, outcome.winner);
+    METRICS_COUNT(Games);
+    METRICS_ADD(Moves, outcome.turns);
+    METRICS_ADD(ConquerAttempts, outcome.conquerAttempts[1] + outcome.conquerAttempts[2]);
+    METRICS_ADD(ConquerSuccesses, outcome.conquerSuccesses[1] + outcome.conquerSuccesses[2]);
+    METRICS_ADD(Forfeits, outcome.forfeits[1] + outcome.forfeits[2]);
+    return outcome;
+}
+
+template GameOutcome playGame<Board>(const Strategy&, const Strategy&, Board, Rng&, GameRecord*);
+template GameOutcome playGame<Board3x3>(const Strategy&, const Strategy&, Board3x3, Rng&, GameRecord*);
+template GameOutcome playGame<Board4x4>(const Strategy&, const Strategy&, Board4x4, Rng&, GameRecord*);
+template GameOutcome playGame<Board15x15>(const Strategy&, const Strategy&, Board15x15, Rng&, GameRecord*);
+
+GameOutcome simulateGame(const Strategy& blue, const Strategy& red, int size, int winLength, Rng& rng) {
+    return withBoard(size, winLength, [&](auto board) { return playGame(blue, red, board, rng); });
+}
+
+// --- Statistics ---
+void SimulationStats::add(const GameOutcome& outcome) {
+    ++games;
+    ++wins[outcome.winner];
+    if (outcome.winner == outcome.firstPlayer) ++firstMoverWins;
+    turns += outcome.turns;
+    for (int player = 1; player <= 2; ++player) {
+        conquerAttempts[player] += outcome.conquerAttempts[player];
+        conquerSuccesses[player] += outcome.conquerSuccesses[player];
+        forfeits[player] += outcome.forfeits[player];
+    }
+}
+
+void SimulationStats::merge(const SimulationStats& other) {
+    games += other.games;
+    firstMoverWins += other.firstMoverWins;
+    turns += other.turns;
+    for (int i = 0; i < 3; ++i) {
+        wins[i] += other.wins[i];
+        conquerAttempts[i] += other.conquerAttempts[i];
+        conquerSuccesses[i] += other.conquerSuccesses[i];
+        forfeits[i] += other.forfeits[i];
+    }
+}
+
+SimulationStats runSimulation(const Strategy& blue, const Strategy& red, const SimulationOptions& options) {
+    uint64_t games = options.games;
+    int threads = options.threads;
+    std::vector<SimulationStats> perThread(threads);
+    std::vector<std::thread> workers;
+    uint64_t first = 0;
+    for (int t = 0; t < threads; ++t) {
+        uint64_t share = games / threads + (static_cast<uint64_t>(t) < games % threads ? 1 : 0);
+        workers.emplace_back([&blue, &red, &perThread, &options, t, first, share]() {
+            // The board type is chosen once for the worker's whole range
+            auto playRange = [&](auto emptyBoard) {
+                SimulationStats local; // Kept on the worker's stack, no false sharing
+                GameRecord record;
+                GameRecord* log = (options.record || options.training) ? &record : nullptr;
+                RecordStream stream(options.record);          // Buffers a block at a time
+                TrainingStream positions(options.training);  // And a chunk of rows
+                for (uint64_t g = first; g < first + share; ++g) {
+                    Rng rng(options.seed, g);
+                    if (log) log->begin(options.seed, g, options.size, options.winLength);
+                    local.add(playGame(blue, red, emptyBoard, rng, log));
+                    if (log) {
+                        stream.add(record);
+                        positions.add(record);
+                    }
+                }
+                return local;
+            };
+            perThread[t] = options.generic ? playRange(Board(options.size, options.winLength))
+                                           : withBoard(options.size, options.winLength, playRange);
+        });
+        first += share;
+    }
+    SimulationStats total;
+    for (int t = 0; t < threads; ++t) {
+        workers[t].join();
+        total.merge(perThread[t]);
+    }
+    return total;
+}
+
+// --- Command Line ---
+namespace {
+
+const char* SIMULATE_USAGE =
+    "Usage: EchoGrid --simulate N [--threads T] [--seed S] [--size N] [--win K] [--blue NAME] [--red NAME] [--generic]\n"
+    "       [--ai-ms MS] [--ai-threads T] [--ai-playouts P] [--tt-mb MB] [--record FILE] [--export FILE]\n"
+    "       [--metrics FILE] [--trace FILE]\n"
+    "Strategies: heuristic, random, solved, mcts\n";
+
+void printStats(const SimulationStats& stats, const Strategy& blue, const Strategy& red, const SimulationOptions& options, double seconds) {
+    int threads = options.threads;
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << "Simulated " << stats.games << " games (" << blue.name() << " vs " << red.name() << ") on "
+              << options.size << "x" << options.size << ", " << options.winLength << " in a row, "
+              << threads << " thread(s)" << (options.generic ? ", generic board" : "")
+              << " in " << std::setprecision(3) << seconds << " s, seed " << options.seed << "\n";
+    std::cout << std::setprecision(0) << " Throughput:        " << (seconds > 0 ? stats.games / seconds : 0.0)
+              << " games/s (" << (seconds > 0 ? stats.games / seconds / threads : 0.0) << " per thread)\n";
+    std::cout << std::setprecision(2);
+    std::cout << " Blue Side wins:    " << percent(stats.wins[1], stats.games) << "%\n";
+    std::cout << " Red Side wins:     " << percent(stats.wins[2], stats.games) << "%\n";
+    std::cout << " Draws:             " << percent(stats.wins[0], stats.games) << "%\n";
+    std::cout << " First mover wins:  " << percent(stats.firstMoverWins, stats.games) << "%\n";
+    std::cout << " Turns per game:    " << (stats.games ? static_cast<double>(stats.turns) / stats.games : 0.0) << "\n";
+    const char* sides[3] = { "", "Blue", "Red" };
+    for (int player = 1; player <= 2; ++player) {
+        std::cout << " " << sides[player] << " conquers:" << (player == 1 ? "     " : "      ")
+                  << stats.conquerAttempts[player] << " attempted, "
+                  << percent(stats.conquerSuccesses[player], stats.conquerAttempts[player]) << "% succeeded, "
+                  << stats.forfeits[player] << " forfeited turns\n";
+    }
+    const Strategy* players[3] = { nullptr, &blue, &red };
+    for (int player = 1; player <= 2; ++player) {
+        std::string summary = players[player]->summary();
+        if (!summary.empty()) std::cout << " " << sides[player] << " " << players[player]->name() << ": " << summary << "\n";
+    }
+}
+
+} // namespace
+
+int simulateCommand(int argc, char* argv[]) {
+    SimulationOptions options;
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    options.seed = randomSeed();
+    std::string blueName = "heuristic";
+    std::string redName = "heuristic";
+    MctsOptions mcts;
+    std::string recordPath;
+    std::string exportPath;
+    std::string metricsPath;
+    std::string tracePath;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        bool valid = true;
+        double tableMb = 0.0;
+        if (arg == "--simulate" && hasValue) valid = parseNumber(argv[++i], options.games);
+        else if (arg == "--threads" && hasValue) valid = parseNumber(argv[++i], options.threads);
+        else if (arg == "--seed" && hasValue) valid = parseNumber(argv[++i], options.seed);
+        else if (arg == "--size" && hasValue) valid = parseNumber(argv[++i], options.size);
+        else if (arg == "--win" && hasValue) valid = parseNumber(argv[++i], options.winLength);
+        else if (arg == "--blue" && hasValue) blueName = argv[++i];
+        else if (arg == "--red" && hasValue) redName = argv[++i];
+        else if (arg == "--generic") options.generic = true;
+        else if (arg == "--ai-ms" && hasValue) valid = parseNumber(argv[++i], mcts.thinkMs);
+        else if (arg == "--ai-threads" && hasValue) valid = parseNumber(argv[++i], mcts.threads);
+        else if (arg == "--ai-playouts" && hasValue) valid = parseNumber(argv[++i], mcts.maxPlayouts);
+        else if (arg == "--tt-mb" && hasValue) {
+            valid = parseNumber(argv[++i], tableMb) && tableMb >= 0.0;
+            mcts.tableBytes = static_cast<size_t>(tableMb * (1 << 20));
+        }
+        else if (arg == "--record" && hasValue) recordPath = argv[++i];
+        else if (arg == "--export" && hasValue) exportPath = argv[++i];
+        else if (arg == "--metrics" && hasValue) metricsPath = argv[++i];
+        else if (arg == "--trace" && hasValue) tracePath = argv[++i];
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n" << SIMULATE_USAGE;
+            return 1;
+        }
+        if (!valid) {
+            std::cout << "Invalid value '" << argv[i] << "' for " << arg << ".\n" << SIMULATE_USAGE;
+            return 1;
+        }
+    }
+    if (options.threads < 1) options.threads = 1;
+    if (mcts.threads < 1) mcts.threads = 1;
+    if (mcts.thinkMs < 0) mcts.thinkMs = 0;
+    if (!isValidGeometry(options.size, options.winLength)) {
+        std::cout << "Board size must be " << MIN_BOARD_SIZE << "-" << MAX_BOARD_SIZE
+                  << " and the win length 3 up to the board size.\n";
+        return 1;
+    }
+    if ((blueName == "solved" || redName == "solved") && !(options.size == CLASSIC_SIZE && options.winLength == CLASSIC_SIZE)) {
+        std::cout << "The solved strategy only knows the classic 3x3 board.\n";
+        return 1;
+    }
+
+    PolicyTable policy;
+    if (blueName == "solved" || redName == "solved") {
+        if (!policy.load(POLICY_FILE)) {
+            std::cout << "Could not load policy table '" << POLICY_FILE << "'.\n";
+            return 1;
+        }
+    }
+    std::unique_ptr<Strategy> blue = makeStrategy(blueName, policy, mcts);
+    std::unique_ptr<Strategy> red = makeStrategy(redName, policy, mcts);
+    if (!blue || !red) {
+        std::cout << "Unknown strategy '" << (blue ? redName : blueName) << "'. Choose heuristic, random, solved or mcts.\n";
+        return 1;
+    }
+
+    RecordWriter writer;
+    if (!recordPath.empty()) {
+        std::string error;
+        if (!writer.open(recordPath, error)) {
+            std::cout << "Could not record games: " << error << ".\n";
+            return 1;
+        }
+        options.record = &writer;
+    }
+    TrainingWriter exporter;
+    if (!exportPath.empty()) {
+        std::string error;
+        if (!exporter.open(exportPath, options.size, options.winLength, error)) {
+            std::cout << "Could not export positions: " << error << ".\n";
+            return 1;
+        }
+        options.training = &exporter;
+    }
+    if ((!metricsPath.empty() || !tracePath.empty()) && !enableMetrics(!tracePath.empty())) {
+        std::cout << "This build has no metrics (ECHOGRID_METRICS=0).\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    SimulationStats stats = runSimulation(*blue, *red, options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printStats(stats, *blue, *red, options, elapsed.count());
+    if (options.record) {
+        if (!writer.close()) {
+            std::cout << "Could not finish writing '" << recordPath << "'.\n";
+            return 1;
+        }
+        std::cout << " Recorded to:       " << recordPath << " (" << writer.games() << " games in the file)\n";
+    }
+    if (options.training) {
+        if (!exporter.close()) {
+            std::cout << "Could not finish writing '" << exportPath << "'.\n";
+            return 1;
+        }
+        std::cout << " Exported to:       " << exportPath << " (" << exporter.rows() << " positions)\n";
+    }
+    if (metricsEnabled()) {
+        printMetrics(std::cout);
+        std::string error;
+        if (!saveMetrics(metricsPath, tracePath, error)) {
+            std::cout << "Could not save metrics: " << error << ".\n";
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,111 @@
+#pragma once
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "AI.h"
+#include "GameRecord.h"
+#include "TrainingData.h"
+#include "Mcts.h"
+
+// --- Headless Simulation ---
+// Plays complete games with the real rules (dice roll, coin toss, conquer,
+// defense toss) but no console, no sleeps and no std::cin, so rule
+// statistics can be gathered over millions of games.
+
+// A pluggable player for the headless engine. There is one chooseAction
+// overload per board type so a game stays on its specialization throughout.
+class Strategy {
+public:
+    virtual ~Strategy() = default;
+    virtual const char* name() const = 0;
+    // Anything worth reporting after a run (e.g. search throughput); empty by default.
+    virtual std::string summary() const { return std::string(); }
+    virtual TurnAction chooseAction(const Board& board, char playerSymbol, bool powerTurn, Rng& rng) const = 0;
+    virtual TurnAction chooseAction(const Board3x3& board, char playerSymbol, bool powerTurn, Rng& rng) const = 0;
+    virtual TurnAction chooseAction(const Board4x4& board, char playerSymbol, bool powerTurn, Rng& rng) const = 0;
+    virtual TurnAction chooseAction(const Board15x15& board, char playerSymbol, bool powerTurn, Rng& rng) const = 0;
+};
+
+// Implements every chooseAction overload by forwarding to Derived::choose,
+// a member template over the board type.
+template <typename Derived>
+class StrategyFor : public Strategy {
+public:
+    TurnAction chooseAction(const Board& board, char playerSymbol, bool powerTurn, Rng& rng) const override {
+        return self().choose(board, playerSymbol, powerTurn, rng);
+    }
+    TurnAction chooseAction(const Board3x3& board, char playerSymbol, bool powerTurn, Rng& rng) const override {
+        return self().choose(board, playerSymbol, powerTurn, rng);
+    }
+    TurnAction chooseAction(const Board4x4& board, char playerSymbol, bool powerTurn, Rng& rng) const override {
+        return self().choose(board, playerSymbol, powerTurn, rng);
+    }
+    TurnAction chooseAction(const Board15x15& board, char playerSymbol, bool powerTurn, Rng& rng) const override {
+        return self().choose(board, playerSymbol, powerTurn, rng);
+    }
+
+private:
+    const Derived& self() const { return static_cast<const Derived&>(*this); }
+};
+
+// Known names: "heuristic", "random", "solved", "mcts". Returns nullptr for
+// anything else. "solved" plays from the given policy table, which must stay
+// loaded; "mcts" searches every move with the given options.
+std::unique_ptr<Strategy> makeStrategy(const std::string& name, const PolicyTable& policy, const MctsOptions& mcts = MctsOptions());
+
+struct GameOutcome {
+    int winner = 0;       // 1 = Blue Side, 2 = Red Side, 0 = draw
+    int firstPlayer = 1;  // Who won the dice roll
+    int turns = 0;
+    int conquerAttempts[3] = { 0, 0, 0 };  // Indexed by player
+    int conquerSuccesses[3] = { 0, 0, 0 };
+    int forfeits[3] = { 0, 0, 0 };
+};
+
+// Plays one game starting from board, which must be empty. Simulation.cpp
+// instantiates it for Board and every FixedBoard specialization. If record
+// is given (already begun), the rolls, every turn and the final board go
+// into it.
+template <typename BoardType>
+GameOutcome playGame(const Strategy& blue, const Strategy& red, BoardType board, Rng& rng, GameRecord* record = nullptr);
+
+// Picks the board type for the geometry, then plays one game on it.
+GameOutcome simulateGame(const Strategy& blue, const Strategy& red, int size, int winLength, Rng& rng);
+
+struct SimulationStats {
+    uint64_t games = 0;
+    uint64_t wins[3] = { 0, 0, 0 };  // Index 0 counts draws
+    uint64_t firstMoverWins = 0;
+    uint64_t turns = 0;
+    uint64_t conquerAttempts[3] = { 0, 0, 0 };
+    uint64_t conquerSuccesses[3] = { 0, 0, 0 };
+    uint64_t forfeits[3] = { 0, 0, 0 };
+
+    void add(const GameOutcome& outcome);
+    void merge(const SimulationStats& other);
+};
+
+struct SimulationOptions {
+    uint64_t games = 1000000;
+    int threads = 1;
+    uint64_t seed = 0;
+    int size = CLASSIC_SIZE;
+    int winLength = CLASSIC_SIZE;
+    bool generic = false; // Always use the runtime-sized Board (for comparison)
+    RecordWriter* record = nullptr; // Where to log every game, if anywhere
+    TrainingWriter* training = nullptr; // Where to export every position, if anywhere
+};
+
+// Splits the games across worker threads, each keeping its own stats.
+// Game g is always played with Rng(seed, g), whichever thread runs it, and
+// every board type plays it identically.
+SimulationStats runSimulation(const Strategy& blue, const Strategy& red, const SimulationOptions& options);
+
+// Entry point for "EchoGrid --simulate N [--threads T] [--seed S] [--size N] [--win K]
+// [--blue NAME] [--red NAME] [--generic] [--ai-ms MS] [--ai-threads T] [--ai-playouts P]
+// [--tt-mb MB] [--record FILE] [--export FILE] [--metrics FILE] [--trace FILE]".
+// "--tt-mb 0" turns the search's transposition table off; "--record" appends
+// every game to a game record file and "--export" writes every position to a
+// training data file. "--metrics" saves the phase timings and counters
+// (JSON, or CSV for a .csv name) and "--trace" a Chrome trace of every phase.
+int simulateCommand(int argc, char* argv[]);
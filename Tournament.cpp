@@ -0,0 +1,371 @@
+#include "Tournament.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Input.h"
+#include "Simulation.h"
+
+namespace {
+
+// No verdict before this many games, and the score variance never counts as
+// lower than this, so a short run of identical results cannot end a pairing.
+const uint64_t MIN_SPRT_GAMES = 16;
+const double MIN_SCORE_VARIANCE = 0.01;
+const char* TOURNAMENT_USAGE =
+    "Usage: EchoGrid --tournament PLAYER,PLAYER[,...] [--games N] [--threads T] [--seed S] [--size N] [--win K]\n"
+    "       [--elo0 E] [--elo1 E] [--alpha A] [--beta B] [--no-sprt] [--ai-ms MS] [--ai-playouts P]\n"
+    "Players: heuristic, random, solved, mcts, or mcts:P for P playouts per move\n";
+
+double scoreOf(double wins, double draws, double losses) {
+    return (wins + 0.5 * draws) / (wins + draws + losses);
+}
+
+double scoreVariance(double wins, double draws, double losses, double score) {
+    double n = wins + draws + losses;
+    return (wins * (1.0 - score) * (1.0 - score) + draws * (0.5 - score) * (0.5 - score) + losses * score * score) / n;
+}
+
+double eloFromScore(double score) {
+    if (score <= 0.0) return -std::numeric_limits<double>::infinity();
+    if (score >= 1.0) return std::numeric_limits<double>::infinity();
+    return -400.0 * std::log10(1.0 / score - 1.0);
+}
+
+double scoreFromElo(double elo) {
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+std::string formatElo(double elo) {
+    if (std::isinf(elo)) return elo > 0 ? "+inf" : "-inf";
+    long rounded = std::lround(elo);
+    return (rounded > 0 ? "+" : "") + std::to_string(rounded);
+}
+
+struct Entrant {
+    std::string name;
+    std::unique_ptr<Strategy> strategy;
+};
+
+// Results are from the first player's point of view.
+struct Pairing {
+    int first = 0;
+    int second = 0;
+    std::mutex mutex;
+    uint64_t wins = 0;
+    uint64_t draws = 0;
+    uint64_t losses = 0;
+    int verdict = 0; // +1 accepted H1, -1 accepted H0, 0 undecided
+    std::atomic<bool> decided{ false };
+
+    uint64_t games() const { return wins + draws + losses; }
+};
+
+// A pair of games with the same seed and the colours swapped.
+struct Task {
+    int pairing;
+    uint64_t pair;
+};
+
+// One worker's tasks. The owner takes from the front and thieves from the
+// back, so they only meet on the last task.
+class TaskQueue {
+public:
+    void push(const Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.push_back(task);
+    }
+    bool pop(Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.front();
+        tasks.pop_front();
+        return true;
+    }
+    bool steal(Task& task) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (tasks.empty()) return false;
+        task = tasks.back();
+        tasks.pop_back();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<Task> tasks;
+};
+
+struct TournamentOptions {
+    uint64_t maxGames = 2000; // Per pairing; the fixed batch SPRT is measured against
+    int threads = 1;
+    uint64_t seed = 0;
+    int size = CLASSIC_SIZE;
+    int winLength = CLASSIC_SIZE;
+    bool sprt = true;
+    double elo0 = 0.0;
+    double elo1 = 20.0;
+    double alpha = 0.05;
+    double beta = 0.05;
+};
+
+// Plays every pairing's tasks on options.threads workers. Returns how many
+// of the pairs played were stolen.
+uint64_t playTournament(const std::vector<Entrant>& entrants, std::vector<std::unique_ptr<Pairing>>& pairings,
+                        const TournamentOptions& options) {
+    double lowerBound = std::log(options.beta / (1.0 - options.alpha));
+    double upperBound = std::log((1.0 - options.beta) / options.alpha);
+
+    // Dealt out pair by pair across pairings, so every pairing starts at once
+    int threads = options.threads;
+    std::vector<TaskQueue> queues(threads);
+    size_t dealt = 0;
+    for (uint64_t pair = 0; pair < options.maxGames / 2; ++pair) {
+        for (size_t p = 0; p < pairings.size(); ++p) queues[dealt++ % threads].push({ static_cast<int>(p), pair });
+    }
+
+    std::atomic<uint64_t> steals{ 0 };
+    auto work = [&](int self) {
+        Task task;
+        while (true) {
+            bool found = queues[self].pop(task);
+            bool stolen = false;
+            for (int k = 1; !found && k < threads; ++k) found = stolen = queues[(self + k) % threads].steal(task);
+            if (!found) return; // Nothing is queued after the start, so everyone is done
+            Pairing& pairing = *pairings[task.pairing];
+            if (pairing.decided) continue;
+            if (stolen) ++steals;
+
+            const Strategy& first = *entrants[pairing.first].strategy;
+            const Strategy& second = *entrants[pairing.second].strategy;
+            uint64_t gameIndex = (static_cast<uint64_t>(task.pairing) << 32) | task.pair;
+            Rng firstAsBlue(options.seed, gameIndex);
+            Rng firstAsRed(options.seed, gameIndex);
+            GameOutcome one = simulateGame(first, second, options.size, options.winLength, firstAsBlue);
+            GameOutcome two = simulateGame(second, first, options.size, options.winLength, firstAsRed);
+
+            std::lock_guard<std::mutex> lock(pairing.mutex);
+            if (pairing.decided) continue; // Settled while these were being played
+            for (int winner : { one.winner, two.winner == 0 ? 0 : 3 - two.winner }) {
+                if (winner == 1) ++pairing.wins;
+                else if (winner == 2) ++pairing.losses;
+                else ++pairing.draws;
+            }
+            if (!options.sprt || pairing.games() < MIN_SPRT_GAMES) continue;
+            double llr = sprtLogLikelihoodRatio(static_cast<double>(pairing.wins), static_cast<double>(pairing.draws),
+                                                static_cast<double>(pairing.losses), options.elo0, options.elo1);
+            if (llr >= upperBound || llr <= lowerBound) {
+                pairing.verdict = (llr >= upperBound) ? 1 : -1;
+                pairing.decided = true;
+            }
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) workers.emplace_back(work, t);
+    for (std::thread& worker : workers) worker.join();
+    return steals;
+}
+
+void printTournament(const std::vector<Entrant>& entrants, const std::vector<std::unique_ptr<Pairing>>& pairings,
+                     const TournamentOptions& options, double seconds, uint64_t steals) {
+    std::cout << "\nPairing                           Games  W-D-L (first's view)   Score     LLR  Verdict\n";
+    uint64_t played = 0;
+    for (const auto& pairing : pairings) {
+        const std::string& first = entrants[pairing->first].name;
+        std::string label = first + " vs " + entrants[pairing->second].name;
+        std::ostringstream record;
+        record << pairing->wins << "-" << pairing->draws << "-" << pairing->losses;
+        double llr = sprtLogLikelihoodRatio(double(pairing->wins), double(pairing->draws), double(pairing->losses),
+                                            options.elo0, options.elo1);
+        std::string verdict = !options.sprt ? "-"
+                              : pairing->verdict > 0 ? first + " stronger"
+                              : pairing->verdict < 0 ? first + " not stronger"
+                                                     : "inconclusive";
+        std::cout << std::left << std::setw(32) << label << std::right << std::setw(7) << pairing->games() << "  "
+                  << std::left << std::setw(21) << record.str() << std::right << std::fixed << std::setprecision(1)
+                  << std::setw(7) << 100.0 * scoreOf(double(pairing->wins), double(pairing->draws), double(pairing->losses)) << "%"
+                  << std::setprecision(2) << std::setw(8) << llr << "  " << verdict << "\n";
+        played += pairing->games();
+    }
+
+    // Every player's record against the whole field
+    struct Standing {
+        int entrant = 0;
+        double wins = 0, draws = 0, losses = 0;
+        EloEstimate elo;
+    };
+    std::vector<Standing> standings(entrants.size());
+    for (size_t e = 0; e < entrants.size(); ++e) standings[e].entrant = static_cast<int>(e);
+    for (const auto& pairing : pairings) {
+        Standing& first = standings[pairing->first];
+        Standing& second = standings[pairing->second];
+        first.wins += pairing->wins;
+        first.draws += pairing->draws;
+        first.losses += pairing->losses;
+        second.wins += pairing->losses;
+        second.draws += pairing->draws;
+        second.losses += pairing->wins;
+    }
+    for (Standing& standing : standings) standing.elo = estimateElo(standing.wins, standing.draws, standing.losses);
+    std::stable_sort(standings.begin(), standings.end(), [](const Standing& a, const Standing& b) { return a.elo.elo > b.elo.elo; });
+
+    std::cout << "\nRank  Player               Games   Score    Elo   95% interval (vs the field)\n";
+    for (size_t rank = 0; rank < standings.size(); ++rank) {
+        const Standing& standing = standings[rank];
+        double games = standing.wins + standing.draws + standing.losses;
+        std::cout << std::left << std::setw(6) << rank + 1 << std::setw(20) << entrants[standing.entrant].name << std::right
+                  << std::setw(7) << static_cast<uint64_t>(games) << std::fixed << std::setprecision(1) << std::setw(7)
+                  << (games > 0 ? 100.0 * scoreOf(standing.wins, standing.draws, standing.losses) : 0.0) << "%"
+                  << std::setw(7) << formatElo(standing.elo.elo) << "   " << formatElo(standing.elo.low) << " to "
+                  << formatElo(standing.elo.high) << "\n";
+    }
+
+    uint64_t budget = (options.maxGames / 2 * 2) * pairings.size();
+    std::cout << std::setprecision(2) << "\nPlayed " << played << " games in " << seconds << " s with " << options.threads
+              << " thread(s), " << steals << " pairs stolen";
+    if (options.sprt && played > 0) {
+        std::cout << "; fixed batches of " << options.maxGames / 2 * 2 << " would have played " << budget << " ("
+                  << std::setprecision(1) << static_cast<double>(budget) / played << "x more)";
+    }
+    std::cout << "\n";
+}
+
+} // namespace
+
+EloEstimate estimateElo(double wins, double draws, double losses) {
+    EloEstimate estimate;
+    double n = wins + draws + losses;
+    if (n <= 0.0) return estimate;
+    double score = scoreOf(wins, draws, losses);
+    double margin = 1.96 * std::sqrt(scoreVariance(wins, draws, losses, score) / n);
+    estimate.elo = eloFromScore(score);
+    estimate.low = eloFromScore(score - margin);
+    estimate.high = eloFromScore(score + margin);
+    return estimate;
+}
+
+double sprtLogLikelihoodRatio(double wins, double draws, double losses, double elo0, double elo1) {
+    double n = wins + draws + losses;
+    if (n <= 0.0) return 0.0;
+    double score = scoreOf(wins, draws, losses);
+    double variance = std::max(scoreVariance(wins, draws, losses, score), MIN_SCORE_VARIANCE);
+    double score0 = scoreFromElo(elo0);
+    double score1 = scoreFromElo(elo1);
+    return n * (score1 - score0) * (2.0 * score - score0 - score1) / (2.0 * variance);
+}
+
+int tournamentCommand(int argc, char* argv[]) {
+    TournamentOptions options;
+    options.threads = static_cast<int>(std::thread::hardware_concurrency());
+    options.seed = randomSeed();
+    std::string roster;
+    MctsOptions mcts;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        bool valid = true;
+        if (arg == "--tournament" && hasValue) roster = argv[++i];
+        else if (arg == "--games" && hasValue) valid = parseNumber(argv[++i], options.maxGames);
+        else if (arg == "--threads" && hasValue) valid = parseNumber(argv[++i], options.threads);
+        else if (arg == "--seed" && hasValue) valid = parseNumber(argv[++i], options.seed);
+        else if (arg == "--size" && hasValue) valid = parseNumber(argv[++i], options.size);
+        else if (arg == "--win" && hasValue) valid = parseNumber(argv[++i], options.winLength);
+        else if (arg == "--elo0" && hasValue) valid = parseNumber(argv[++i], options.elo0);
+        else if (arg == "--elo1" && hasValue) valid = parseNumber(argv[++i], options.elo1);
+        else if (arg == "--alpha" && hasValue) valid = parseNumber(argv[++i], options.alpha);
+        else if (arg == "--beta" && hasValue) valid = parseNumber(argv[++i], options.beta);
+        else if (arg == "--no-sprt") options.sprt = false;
+        else if (arg == "--ai-ms" && hasValue) valid = parseNumber(argv[++i], mcts.thinkMs);
+        else if (arg == "--ai-playouts" && hasValue) valid = parseNumber(argv[++i], mcts.maxPlayouts);
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n" << TOURNAMENT_USAGE;
+            return 1;
+        }
+        if (!valid) {
+            std::cout << "Invalid value '" << argv[i] << "' for " << arg << ".\n" << TOURNAMENT_USAGE;
+            return 1;
+        }
+    }
+    if (options.threads < 1) options.threads = 1;
+    if (options.maxGames < 2) options.maxGames = 2;
+    if (!isValidGeometry(options.size, options.winLength)) {
+        std::cout << "Board size must be " << MIN_BOARD_SIZE << "-" << MAX_BOARD_SIZE
+                  << " and the win length 3 up to the board size.\n";
+        return 1;
+    }
+    if (!(options.alpha > 0.0 && options.alpha < 1.0 && options.beta > 0.0 && options.beta < 1.0 && options.elo1 > options.elo0)) {
+        std::cout << "SPRT needs elo1 above elo0 and alpha and beta between 0 and 1.\n";
+        return 1;
+    }
+
+    std::vector<std::string> names;
+    std::stringstream list(roster);
+    for (std::string name; std::getline(list, name, ',');) {
+        if (!name.empty()) names.push_back(name);
+    }
+    if (names.size() < 2) {
+        std::cout << "A tournament needs at least two players, e.g. --tournament heuristic,random\n";
+        return 1;
+    }
+
+    PolicyTable policy;
+    std::vector<Entrant> entrants;
+    for (const std::string& name : names) {
+        if (name == "solved" && !policy.isLoaded()) {
+            if (options.size != CLASSIC_SIZE || options.winLength != CLASSIC_SIZE) {
+                std::cout << "The solved strategy only knows the classic 3x3 board.\n";
+                return 1;
+            }
+            if (!policy.load(POLICY_FILE)) {
+                std::cout << "Could not load policy table '" << POLICY_FILE << "'.\n";
+                return 1;
+            }
+        }
+        MctsOptions playerMcts = mcts;
+        std::string base = name;
+        if (name.compare(0, 5, "mcts:") == 0) {
+            base = "mcts";
+            playerMcts.maxPlayouts = std::strtoull(name.c_str() + 5, nullptr, 10);
+            playerMcts.thinkMs = 0;
+            if (playerMcts.maxPlayouts == 0) base.clear();
+        }
+        std::unique_ptr<Strategy> strategy = makeStrategy(base, policy, playerMcts);
+        if (!strategy) {
+            std::cout << "Unknown player '" << name << "'. Choose heuristic, random, solved, mcts or mcts:P.\n";
+            return 1;
+        }
+        entrants.push_back({ name, std::move(strategy) });
+    }
+
+    std::vector<std::unique_ptr<Pairing>> pairings;
+    for (size_t a = 0; a < entrants.size(); ++a) {
+        for (size_t b = a + 1; b < entrants.size(); ++b) {
+            pairings.emplace_back(new Pairing());
+            pairings.back()->first = static_cast<int>(a);
+            pairings.back()->second = static_cast<int>(b);
+        }
+    }
+
+    std::cout << "Tournament: " << entrants.size() << " players, " << pairings.size() << " pairings on " << options.size << "x"
+              << options.size << ", " << options.winLength << " in a row, up to " << options.maxGames / 2 * 2
+              << " games per pairing, seed " << options.seed << "\n";
+    if (options.sprt) {
+        std::cout << "SPRT: H0 elo " << options.elo0 << ", H1 elo " << options.elo1 << ", alpha " << options.alpha
+                  << ", beta " << options.beta << "\n";
+    }
+    auto start = std::chrono::steady_clock::now();
+    uint64_t steals = playTournament(entrants, pairings, options);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    printTournament(entrants, pairings, options, elapsed.count(), steals);
+    return 0;
+}
@@ -0,0 +1,36 @@
+#pragma once
+#include <cstdint>
+
+// --- Tournament ---
+// Round-robin matches between named AI players to tell whether a change
+// made one stronger. Games come in pairs that share a seed with the colours
+// swapped, so both players see the same dice and coins from each side and
+// each moves first equally often. Every pair is a task; worker threads take
+// tasks from their own queue and steal from the others' when it runs dry,
+// so a slow pairing (say, one with a search player) never leaves cores
+// idle while others finish.
+//
+// Each pairing stops as soon as a sequential probability ratio test is
+// decisive: H0 "the first player is no stronger than elo0" against H1 "it
+// is elo1 stronger", from its wins, draws and losses. Lopsided pairings are
+// settled in a few dozen games instead of the full budget.
+
+struct EloEstimate {
+    double elo = 0.0;  // From the score; +/-inf at 100% or 0%
+    double low = 0.0;  // 95% confidence interval
+    double high = 0.0;
+};
+
+// Elo difference implied by a record, with a 95% interval from the
+// per-game variance of the score.
+EloEstimate estimateElo(double wins, double draws, double losses);
+
+// Log-likelihood ratio of H1 (elo1) over H0 (elo0) for a win/draw/loss
+// record, using the normal approximation to the trinomial score.
+double sprtLogLikelihoodRatio(double wins, double draws, double losses, double elo0, double elo1);
+
+// Entry point for "EchoGrid --tournament PLAYER,PLAYER[,...] [--games N] [--threads T]
+// [--seed S] [--size N] [--win K] [--elo0 E] [--elo1 E] [--alpha A] [--beta B]
+// [--no-sprt] [--ai-ms MS] [--ai-playouts P]". A player is a strategy name;
+// "mcts:P" searches P playouts per move, so budgets can be compared.
+int tournamentCommand(int argc, char* argv[]);
@@ -0,0 +1,355 @@
+#include "TrainingData.h"
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h> // For CreateFileMapping and MapViewOfFile
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+size_t alignColumn(size_t bytes) {
+    return (bytes + TRAINING_ALIGNMENT - 1) & ~(TRAINING_ALIGNMENT - 1);
+}
+
+int planeWordsFor(int size) {
+    return (size * size + 63) / 64;
+}
+
+double percent(uint64_t part, uint64_t whole) {
+    return whole == 0 ? 0.0 : 100.0 * static_cast<double>(part) / static_cast<double>(whole);
+}
+
+} // namespace
+
+TrainingLayout::TrainingLayout(uint32_t rows, int planeWords) {
+    size_t planeBytes = alignColumn(static_cast<size_t>(rows) * planeWords * sizeof(uint64_t));
+    blue = 0;
+    red = blue + planeBytes;
+    toMove = red + planeBytes;
+    power = toMove + alignColumn(rows);
+    action = power + alignColumn(rows);
+    target = action + alignColumn(rows);
+    defense = target + alignColumn(rows * sizeof(int16_t));
+    result = defense + alignColumn(rows);
+    bytes = result + alignColumn(rows);
+}
+
+// --- Writing ---
+bool TrainingWriter::open(const std::string& path, int size, int winLength, std::string& error) {
+    close();
+    file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) {
+        error = "could not open '" + path + "' for writing";
+        return false;
+    }
+    words = planeWordsFor(size);
+    TrainingFileHeader header = {};
+    std::memcpy(header.magic, "EGTD", 4);
+    header.version = TRAINING_VERSION;
+    header.size = static_cast<uint8_t>(size);
+    header.winLength = static_cast<uint8_t>(winLength);
+    header.planeWords = static_cast<uint16_t>(words);
+    failed = std::fwrite(&header, sizeof(header), 1, file) != 1;
+    rowCount = 0;
+    return true;
+}
+
+void TrainingWriter::writeChunk(const uint8_t* columns, uint32_t rows, uint64_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr) return;
+    TrainingChunkHeader header = {};
+    std::memcpy(header.magic, "EGTC", 4);
+    header.rows = rows;
+    header.bytes = bytes;
+    failed |= std::fwrite(&header, sizeof(header), 1, file) != 1 || std::fwrite(columns, 1, static_cast<size_t>(bytes), file) != bytes;
+    rowCount += rows;
+}
+
+bool TrainingWriter::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (file == nullptr) return !failed;
+    failed |= std::fclose(file) != 0;
+    file = nullptr;
+    return !failed;
+}
+
+TrainingStream::TrainingStream(TrainingWriter* writer)
+    : writer(writer), words(writer != nullptr ? writer->planeWords() : 0) {}
+
+void TrainingStream::add(const GameRecord& game) {
+    if (writer == nullptr) return;
+    size_t firstRow = toMove.size();
+    Board board(game.size, game.winLength);
+    board.toMove = (game.blueRoll > game.redRoll) ? 1 : 2;
+    for (const TurnRecord& turn : game.turns) {
+        blue.insert(blue.end(), board.p1.words, board.p1.words + words);
+        red.insert(red.end(), board.p2.words, board.p2.words + words);
+        toMove.push_back(board.toMove);
+        power.push_back(turn.coinCall == turn.coinResult ? 1 : 0);
+        target.push_back(turn.square);
+
+        int claimedSquare = -1;
+        TurnOutcome outcome = applyTurn(board, turn, claimedSquare);
+        action.push_back(outcome == TurnOutcome::Forfeited ? TRAINING_ACTION_FORFEIT
+                         : turn.conquer ? TRAINING_ACTION_CONQUER : TRAINING_ACTION_PLACE);
+        defense.push_back(outcome == TurnOutcome::Conquered ? TRAINING_DEFENSE_LOST
+                          : outcome == TurnOutcome::Defended ? TRAINING_DEFENSE_HELD : TRAINING_DEFENSE_NONE);
+        board.toMove = (board.toMove == 1) ? 2 : 1;
+    }
+    // The outcome is only known now, for every row of the game
+    for (size_t row = firstRow; row < toMove.size(); ++row) {
+        result.push_back(static_cast<int8_t>(game.winner == 0 ? 0 : game.winner == toMove[row] ? 1 : -1));
+    }
+    if (toMove.size() >= TRAINING_CHUNK_ROWS) flush();
+}
+
+void TrainingStream::flush() {
+    if (writer == nullptr || toMove.empty()) return;
+    uint32_t rows = static_cast<uint32_t>(toMove.size());
+    TrainingLayout layout(rows, words);
+    packed.assign(layout.bytes, 0);
+    std::memcpy(packed.data() + layout.blue, blue.data(), blue.size() * sizeof(uint64_t));
+    std::memcpy(packed.data() + layout.red, red.data(), red.size() * sizeof(uint64_t));
+    std::memcpy(packed.data() + layout.toMove, toMove.data(), rows);
+    std::memcpy(packed.data() + layout.power, power.data(), rows);
+    std::memcpy(packed.data() + layout.action, action.data(), rows);
+    std::memcpy(packed.data() + layout.target, target.data(), rows * sizeof(int16_t));
+    std::memcpy(packed.data() + layout.defense, defense.data(), rows);
+    std::memcpy(packed.data() + layout.result, result.data(), rows);
+    writer->writeChunk(packed.data(), rows, layout.bytes);
+    blue.clear();
+    red.clear();
+    toMove.clear();
+    power.clear();
+    action.clear();
+    target.clear();
+    defense.clear();
+    result.clear();
+}
+
+// --- Reading ---
+bool TrainingReader::open(const std::string& path, std::string& error) {
+    close();
+    error = "could not read '" + path + "'";
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart < static_cast<LONGLONG>(sizeof(TrainingFileHeader))) {
+        CloseHandle(file);
+        error = "'" + path + "' is not a training data file";
+        return false;
+    }
+    HANDLE view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file); // The mapping keeps the file open
+    if (view == nullptr) return false;
+    void* mapped = MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0);
+    if (mapped == nullptr) {
+        CloseHandle(view);
+        return false;
+    }
+    fileMapping = view;
+    mappedSize = static_cast<size_t>(size.QuadPart);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(TrainingFileHeader)) {
+        ::close(fd);
+        error = "'" + path + "' is not a training data file";
+        return false;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd); // The mapping keeps the file open
+    if (mapped == MAP_FAILED) return false;
+    mappedSize = static_cast<size_t>(info.st_size);
+#endif
+    data = static_cast<const uint8_t*>(mapped);
+
+    const TrainingFileHeader* header = reinterpret_cast<const TrainingFileHeader*>(data);
+    if (std::memcmp(header->magic, "EGTD", 4) != 0 || header->version != TRAINING_VERSION ||
+        !isValidGeometry(header->size, header->winLength) || header->planeWords != planeWordsFor(header->size)) {
+        close();
+        error = "'" + path + "' is not a training data file";
+        return false;
+    }
+    boardSize = header->size;
+    boardWinLength = header->winLength;
+    words = header->planeWords;
+    error.clear();
+
+    // Chunks up to the first incomplete one; the mapping is page aligned, so
+    // every column is 64-byte aligned in memory as well as in the file
+    size_t offset = sizeof(TrainingFileHeader);
+    while (offset + sizeof(TrainingChunkHeader) <= mappedSize) {
+        const TrainingChunkHeader* chunk = reinterpret_cast<const TrainingChunkHeader*>(data + offset);
+        if (std::memcmp(chunk->magic, "EGTC", 4) != 0) break;
+        TrainingLayout layout(chunk->rows, words);
+        const uint8_t* columns = data + offset + sizeof(TrainingChunkHeader);
+        if (chunk->bytes != layout.bytes || offset + sizeof(TrainingChunkHeader) + layout.bytes > mappedSize) break;
+        TrainingChunk view;
+        view.rows = chunk->rows;
+        view.blue = reinterpret_cast<const uint64_t*>(columns + layout.blue);
+        view.red = reinterpret_cast<const uint64_t*>(columns + layout.red);
+        view.toMove = columns + layout.toMove;
+        view.power = columns + layout.power;
+        view.action = columns + layout.action;
+        view.target = reinterpret_cast<const int16_t*>(columns + layout.target);
+        view.defense = columns + layout.defense;
+        view.result = reinterpret_cast<const int8_t*>(columns + layout.result);
+        chunkViews.push_back(view);
+        rowCount += chunk->rows;
+        offset += sizeof(TrainingChunkHeader) + layout.bytes;
+    }
+    return true;
+}
+
+void TrainingReader::close() {
+    if (data != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(data);
+        CloseHandle(fileMapping);
+        fileMapping = nullptr;
+#else
+        munmap(const_cast<uint8_t*>(data), mappedSize);
+#endif
+    }
+    data = nullptr;
+    mappedSize = 0;
+    rowCount = 0;
+    chunkViews.clear();
+}
+
+// --- Symmetry Augmentation ---
+TrainingSymmetry::TrainingSymmetry(int size) : cells(size * size), words(planeWordsFor(size)), map(COUNT * size * size) {
+    int m = size - 1;
+    for (int cell = 0; cell < cells; ++cell) {
+        int r = cell / size;
+        int c = cell % size;
+        const int images[COUNT][2] = {
+            { r, c }, { c, m - r }, { m - r, m - c }, { m - c, r },  // Rotations
+            { r, m - c }, { m - r, c }, { c, r }, { m - c, m - r }   // Reflections
+        };
+        for (int s = 0; s < COUNT; ++s) {
+            map[s * cells + cell] = static_cast<uint16_t>(images[s][0] * size + images[s][1]);
+        }
+    }
+}
+
+void TrainingSymmetry::transform(int symmetry, const uint64_t* plane, uint64_t* out) const {
+    const uint16_t* image = map.data() + symmetry * cells;
+    for (int w = 0; w < words; ++w) out[w] = 0;
+    for (int w = 0; w < words; ++w) {
+        for (uint64_t bits = plane[w]; bits != 0; bits &= bits - 1) {
+            int to = image[w * 64 + lowestBit(bits)];
+            out[to >> 6] |= 1ull << (to & 63);
+        }
+    }
+}
+
+// --- Command Line ---
+int inspectCommand(int argc, char* argv[]) {
+    std::string path;
+    bool augment = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--inspect" && hasValue) path = argv[++i];
+        else if (arg == "--augment") augment = true;
+        else {
+            std::cout << "Unknown option '" << arg << "'.\nUsage: EchoGrid --inspect FILE [--augment]\n";
+            return 1;
+        }
+    }
+    if (path.empty()) {
+        std::cout << "Usage: EchoGrid --inspect FILE [--augment]\n";
+        return 1;
+    }
+
+    TrainingReader reader;
+    std::string error;
+    if (!reader.open(path, error)) {
+        std::cout << "Could not open training data: " << error << ".\n";
+        return 1;
+    }
+
+    // Column sums, read in place
+    uint64_t powerTurns = 0;
+    uint64_t actions[3] = { 0, 0, 0 };
+    uint64_t defenses[3] = { 0, 0, 0 };
+    uint64_t results[3] = { 0, 0, 0 }; // Lost, drew, won
+    auto start = std::chrono::steady_clock::now();
+    for (const TrainingChunk& chunk : reader.chunks()) {
+        for (uint32_t r = 0; r < chunk.rows; ++r) {
+            powerTurns += chunk.power[r];
+            ++actions[chunk.action[r] % 3];
+            ++defenses[chunk.defense[r] % 3];
+            ++results[chunk.result[r] + 1];
+        }
+    }
+    std::chrono::duration<double> scanTime = std::chrono::steady_clock::now() - start;
+
+    uint64_t rows = reader.rows();
+    std::cout << std::fixed << std::setprecision(1);
+    std::cout << path << ": " << reader.size() << "x" << reader.size() << " with " << reader.winLength() << " in a row, "
+              << rows << " rows in " << reader.chunks().size() << " chunks, " << reader.fileBytes() / double(1 << 20)
+              << " MB (" << (rows ? double(reader.fileBytes()) / rows : 0.0) << " bytes/row)\n";
+    std::cout << std::setprecision(2);
+    std::cout << " Power turns:       " << percent(powerTurns, rows) << "%\n";
+    std::cout << " Actions:           place " << percent(actions[TRAINING_ACTION_PLACE], rows) << "%, conquer "
+              << percent(actions[TRAINING_ACTION_CONQUER], rows) << "%, forfeit " << percent(actions[TRAINING_ACTION_FORFEIT], rows) << "%\n";
+    std::cout << " Conquers:          " << percent(defenses[TRAINING_DEFENSE_LOST], defenses[TRAINING_DEFENSE_LOST] + defenses[TRAINING_DEFENSE_HELD])
+              << "% succeeded\n";
+    std::cout << " Mover's result:    won " << percent(results[2], rows) << "%, drew " << percent(results[1], rows)
+              << "%, lost " << percent(results[0], rows) << "%\n";
+    std::cout << std::setprecision(3) << " Read in " << scanTime.count() << " s (" << std::setprecision(1)
+              << (scanTime.count() > 0 ? rows / scanTime.count() / 1e6 : 0.0) << " M rows/s)\n";
+    if (!augment) return 0;
+
+    // Every row under every symmetry: the same number of marks on each
+    // side, and the target square still held by whoever held it
+    TrainingSymmetry symmetry(reader.size());
+    int words = reader.planeWords();
+    std::vector<uint64_t> blue(words), red(words);
+    uint64_t inconsistent = 0;
+    start = std::chrono::steady_clock::now();
+    for (const TrainingChunk& chunk : reader.chunks()) {
+        for (uint32_t r = 0; r < chunk.rows; ++r) {
+            const uint64_t* sourceBlue = chunk.blue + static_cast<size_t>(r) * words;
+            const uint64_t* sourceRed = chunk.red + static_cast<size_t>(r) * words;
+            int square = chunk.target[r];
+            bool targetBlue = square >= 0 && ((sourceBlue[square >> 6] >> (square & 63)) & 1);
+            bool targetRed = square >= 0 && ((sourceRed[square >> 6] >> (square & 63)) & 1);
+            for (int s = 0; s < TrainingSymmetry::COUNT; ++s) {
+                symmetry.transform(s, sourceBlue, blue.data());
+                symmetry.transform(s, sourceRed, red.data());
+                int image = symmetry.square(s, square);
+                bool ok = (image < 0) || (targetBlue == (((blue[image >> 6] >> (image & 63)) & 1) != 0) &&
+                                          targetRed == (((red[image >> 6] >> (image & 63)) & 1) != 0));
+                int blueMarks = 0;
+                int redMarks = 0;
+                for (int w = 0; w < words; ++w) {
+                    ok &= (blue[w] & red[w]) == 0;
+                    blueMarks += countBits(blue[w]) - countBits(sourceBlue[w]);
+                    redMarks += countBits(red[w]) - countBits(sourceRed[w]);
+                }
+                ok &= blueMarks == 0 && redMarks == 0;
+                if (!ok) ++inconsistent;
+            }
+        }
+    }
+    std::chrono::duration<double> augmentTime = std::chrono::steady_clock::now() - start;
+    std::cout << " Augmented:         " << rows * TrainingSymmetry::COUNT << " rows in " << std::setprecision(3)
+              << augmentTime.count() << " s (" << std::setprecision(1)
+              << (augmentTime.count() > 0 ? rows * TrainingSymmetry::COUNT / augmentTime.count() / 1e6 : 0.0)
+              << " M rows/s), " << inconsistent << " inconsistent\n";
+    return inconsistent == 0 ? 0 : 1;
+}
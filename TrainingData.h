@@ -0,0 +1,179 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "Board.h"
+#include "GameRecord.h"
+
+// --- Training Data ---
+// Every position reached in bulk simulation, one row per turn, for training
+// a policy for the place-or-conquer decision. The file is columnar with
+// fixed-width columns so a reader can map it and hand each column to a
+// training loop as a plain array:
+//
+//   TrainingFileHeader | chunk | chunk | ...
+//
+// A chunk is a TrainingChunkHeader, then each column for all its rows in
+// the order below, every column starting on a 64-byte boundary. Chunks are
+// built per thread and appended whole, so writers only meet to append.
+//
+//   blue, red   planeWords 64-bit words per row: the squares each side holds
+//   toMove      1 or 2
+//   power       1 on a power turn
+//   action      TRAINING_ACTION_*
+//   target      int16 square placed on or targeted, -1 for none
+//   defense     TRAINING_DEFENSE_*
+//   result      +1 the mover went on to win, 0 draw, -1 lost
+//
+// The eight board symmetries are not stored; TrainingSymmetry maps a row
+// onto any of them while it is read.
+
+const uint32_t TRAINING_VERSION = 1;
+const size_t TRAINING_ALIGNMENT = 64;
+const uint32_t TRAINING_CHUNK_ROWS = 16384; // A stream appends its chunk once it holds this many
+
+const uint8_t TRAINING_ACTION_PLACE = 0;
+const uint8_t TRAINING_ACTION_CONQUER = 1;
+const uint8_t TRAINING_ACTION_FORFEIT = 2; // The turn was forfeited, whatever was tried
+
+const uint8_t TRAINING_DEFENSE_NONE = 0;
+const uint8_t TRAINING_DEFENSE_HELD = 1;
+const uint8_t TRAINING_DEFENSE_LOST = 2;
+
+struct TrainingFileHeader {
+    char magic[4]; // "EGTD"
+    uint32_t version;
+    uint8_t size;
+    uint8_t winLength;
+    uint16_t planeWords;
+    uint32_t reserved[13]; // Pads the header to TRAINING_ALIGNMENT
+};
+
+struct TrainingChunkHeader {
+    char magic[4]; // "EGTC"
+    uint32_t rows;
+    uint64_t bytes; // Everything after the header, padding included
+    uint64_t reserved[6];
+};
+
+// Where each column starts, relative to the end of the chunk header.
+struct TrainingLayout {
+    size_t blue, red, toMove, power, action, target, defense, result, bytes;
+    TrainingLayout(uint32_t rows, int planeWords);
+};
+
+// --- Writing ---
+class TrainingWriter {
+public:
+    TrainingWriter() = default;
+    ~TrainingWriter() { close(); }
+    TrainingWriter(const TrainingWriter&) = delete;
+    TrainingWriter& operator=(const TrainingWriter&) = delete;
+
+    // Starts a new file for one board geometry.
+    bool open(const std::string& path, int size, int winLength, std::string& error);
+    void writeChunk(const uint8_t* columns, uint32_t rows, uint64_t bytes);
+    bool close();
+    int planeWords() const { return words; }
+    uint64_t rows() const { return rowCount; }
+
+private:
+    FILE* file = nullptr;
+    std::mutex mutex;
+    int words = 0;
+    uint64_t rowCount = 0;
+    bool failed = false;
+};
+
+// Turns finished games into rows of its own chunk and hands full chunks to
+// a writer. One per thread; a null writer exports nothing.
+class TrainingStream {
+public:
+    explicit TrainingStream(TrainingWriter* writer);
+    ~TrainingStream() { flush(); }
+    TrainingStream(const TrainingStream&) = delete;
+    TrainingStream& operator=(const TrainingStream&) = delete;
+
+    void add(const GameRecord& game);
+    void flush();
+
+private:
+    TrainingWriter* writer;
+    int words;
+    std::vector<uint64_t> blue, red;
+    std::vector<uint8_t> toMove, power, action, defense;
+    std::vector<int16_t> target;
+    std::vector<int8_t> result;
+    std::vector<uint8_t> packed;
+};
+
+// --- Reading ---
+// One chunk's columns, pointing straight into the mapped file.
+struct TrainingChunk {
+    uint32_t rows = 0;
+    const uint64_t* blue = nullptr; // Row r's plane starts at blue + r * planeWords
+    const uint64_t* red = nullptr;
+    const uint8_t* toMove = nullptr;
+    const uint8_t* power = nullptr;
+    const uint8_t* action = nullptr;
+    const int16_t* target = nullptr;
+    const uint8_t* defense = nullptr;
+    const int8_t* result = nullptr;
+};
+
+class TrainingReader {
+public:
+    TrainingReader() = default;
+    ~TrainingReader() { close(); }
+    TrainingReader(const TrainingReader&) = delete;
+    TrainingReader& operator=(const TrainingReader&) = delete;
+
+    bool open(const std::string& path, std::string& error);
+    void close();
+
+    int size() const { return boardSize; }
+    int winLength() const { return boardWinLength; }
+    int planeWords() const { return words; }
+    uint64_t rows() const { return rowCount; }
+    uint64_t fileBytes() const { return mappedSize; }
+    const std::vector<TrainingChunk>& chunks() const { return chunkViews; }
+
+private:
+    const uint8_t* data = nullptr;
+    size_t mappedSize = 0;
+#if defined(_WIN32)
+    void* fileMapping = nullptr;
+#endif
+    int boardSize = 0;
+    int boardWinLength = 0;
+    int words = 0;
+    uint64_t rowCount = 0;
+    std::vector<TrainingChunk> chunkViews;
+};
+
+// --- Symmetry Augmentation ---
+// The 8 rotations and reflections of an N x N board, in the same order as
+// the FixedBoard symmetry tables (0 is the identity). Applied per row as it
+// is read, so augmented data never touches the disk.
+class TrainingSymmetry {
+public:
+    static const int COUNT = 8;
+
+    explicit TrainingSymmetry(int size);
+    int square(int symmetry, int square) const { return square < 0 ? square : map[symmetry * cells + square]; }
+    // Writes plane (planeWords words) as seen under symmetry into out.
+    void transform(int symmetry, const uint64_t* plane, uint64_t* out) const;
+
+private:
+    int cells;
+    int words;
+    std::vector<uint16_t> map;
+};
+
+// Entry point for "EchoGrid --inspect FILE [--augment]": summarizes a
+// training file by reading every column in place; --augment also walks all
+// eight symmetries of every row and checks that each stays consistent.
+int inspectCommand(int argc, char* argv[]);
@@ -0,0 +1,194 @@
+#include "Transcript.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <sstream>
+#include "Screen.h"
+#include "Session.h"
+
+namespace {
+
+const char* SCRIPT_EXTENSION = ".session";
+const char* GOLDEN_EXTENSION = ".golden";
+const char* OPTIONS_PREFIX = "options:";
+
+bool readTextFile(const std::string& path, std::string& text) {
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (file == nullptr) return false;
+    text.clear();
+    char buffer[4096];
+    size_t got;
+    while ((got = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, got);
+    bool ok = !std::ferror(file);
+    std::fclose(file);
+    return ok;
+}
+
+bool writeTextFile(const std::string& path, const std::string& text) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (file == nullptr) return false;
+    bool ok = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    return (std::fclose(file) == 0) && ok;
+}
+
+std::vector<std::string> splitLines(const std::string& text) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) end = text.size();
+        std::string line = text.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        lines.push_back(line);
+        start = end + 1;
+    }
+    return lines;
+}
+
+// Where two transcripts first part, as a 1-based line number, or 0 if they match.
+size_t firstDifference(const std::vector<std::string>& expected, const std::vector<std::string>& actual) {
+    size_t lines = std::max(expected.size(), actual.size());
+    for (size_t i = 0; i < lines; ++i) {
+        if (i >= expected.size() || i >= actual.size() || expected[i] != actual[i]) return i + 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+// --- Session Scripts ---
+bool readSessionScript(const std::string& path, SessionScript& script, std::string& error) {
+    std::string text;
+    if (!readTextFile(path, text)) {
+        error = "could not read '" + path + "'";
+        return false;
+    }
+    std::vector<std::string> lines = splitLines(text);
+    size_t i = 0;
+    while (i < lines.size() && (lines[i].empty() || lines[i][0] == '#')) ++i;
+    if (i == lines.size() || lines[i].compare(0, std::strlen(OPTIONS_PREFIX), OPTIONS_PREFIX) != 0) {
+        error = "'" + path + "' has no options line";
+        return false;
+    }
+    script.options = lines[i].substr(std::strlen(OPTIONS_PREFIX));
+    script.lines.assign(lines.begin() + i + 1, lines.end());
+    return true;
+}
+
+bool replaySession(const SessionScript& script, std::string& transcript, std::string& error) {
+    std::vector<std::string> args;
+    std::istringstream words(script.options);
+    for (std::string word; words >> word;) args.push_back(word);
+    SessionOptions options;
+    if (!parseSessionOptions(args, options, error)) return false;
+    options.animationSpeed = 0.0;
+
+    Screen screen(ScreenTarget::Discard);
+    transcript.clear();
+    screen.setTranscript(&transcript);
+    ScriptInput input(script.lines);
+    bool finished = playSession(options, screen, input);
+    screen.finish();
+    if (!finished) transcript += "--- Input ended ---\n";
+    return true;
+}
+
+CapturingInput::CapturingInput(InputSource& source, FILE* out, const std::string& options)
+    : source(source), out(out) {
+    std::fprintf(out, "# EchoGrid session\n%s %s\n", OPTIONS_PREFIX, options.c_str());
+    std::fflush(out);
+}
+
+std::string CapturingInput::takeLine() {
+    std::string line = source.takeLine();
+    std::fprintf(out, "%s\n", line.c_str());
+    std::fflush(out);
+    return line;
+}
+
+// --- Golden Transcripts ---
+int goldenCommand(int argc, char* argv[]) {
+    std::string path;
+    bool update = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = (i + 1 < argc);
+        if (arg == "--golden" && hasValue) path = argv[++i];
+        else if (arg == "--update") update = true;
+        else {
+            std::cout << "Unknown option '" << arg << "'.\n"
+                      << "Usage: EchoGrid --golden SCRIPT|DIRECTORY [--update]\n";
+            return 1;
+        }
+    }
+    if (path.empty()) {
+        std::cout << "Usage: EchoGrid --golden SCRIPT|DIRECTORY [--update]\n";
+        return 1;
+    }
+
+    std::vector<std::string> scripts;
+    std::error_code status;
+    if (std::filesystem::is_directory(path, status)) {
+        for (const auto& entry : std::filesystem::directory_iterator(path, status)) {
+            if (entry.path().extension() == SCRIPT_EXTENSION) scripts.push_back(entry.path().string());
+        }
+        std::sort(scripts.begin(), scripts.end());
+    }
+    else {
+        scripts.push_back(path);
+    }
+    if (scripts.empty()) {
+        std::cout << "No " << SCRIPT_EXTENSION << " scripts in '" << path << "'.\n";
+        return 1;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    int failed = 0;
+    int updated = 0;
+    for (const std::string& scriptPath : scripts) {
+        std::string name = std::filesystem::path(scriptPath).stem().string();
+        std::string goldenPath = std::filesystem::path(scriptPath).replace_extension(GOLDEN_EXTENSION).string();
+        SessionScript script;
+        std::string transcript, expected, error;
+        if (!readSessionScript(scriptPath, script, error) || !replaySession(script, transcript, error)) {
+            std::cout << " " << name << ": " << error << "\n";
+            ++failed;
+            continue;
+        }
+        bool hasGolden = readTextFile(goldenPath, expected);
+        if (hasGolden && expected == transcript) {
+            std::cout << " " << name << ": ok\n";
+            continue;
+        }
+        if (update) {
+            if (!writeTextFile(goldenPath, transcript)) {
+                std::cout << " " << name << ": could not write '" << goldenPath << "'\n";
+                ++failed;
+                continue;
+            }
+            std::cout << " " << name << ": " << (hasGolden ? "updated" : "created") << "\n";
+            ++updated;
+            continue;
+        }
+        ++failed;
+        if (!hasGolden) {
+            std::cout << " " << name << ": no golden transcript '" << goldenPath << "' (--update writes it)\n";
+            continue;
+        }
+        std::vector<std::string> want = splitLines(expected);
+        std::vector<std::string> got = splitLines(transcript);
+        size_t line = firstDifference(want, got);
+        std::cout << " " << name << ": differs from line " << line << "\n"
+                  << "   expected: " << (line <= want.size() ? want[line - 1] : "<end of transcript>") << "\n"
+                  << "   actual:   " << (line <= got.size() ? got[line - 1] : "<end of transcript>") << "\n";
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "\n " << scripts.size() << " sessions replayed in " << static_cast<int>(seconds * 1000.0 + 0.5) << " ms: "
+              << (scripts.size() - failed) << " passed, " << failed << " failed";
+    if (updated > 0) std::cout << ", " << updated << " golden transcripts written";
+    std::cout << ".\n";
+    return failed == 0 ? 0 : 1;
+}
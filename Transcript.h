@@ -0,0 +1,58 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "Input.h"
+
+// --- Session Scripts and Golden Transcripts ---
+// A session script is everything needed to play an interactive session
+// again: its options, seed included, and every line typed, in order.
+//
+//     # Comments, before the options line only
+//     options: --seed 7 --size 3 --win 3 --ai heuristic
+//     2
+//     <every further line is input, verbatim, blank lines included>
+//
+// Replaying one feeds the lines to the real session (title, menus, rules
+// and game) through a ScriptInput with every animation skipped, and keeps
+// each frame as plain text. Next to every NAME.session in a directory sits
+// NAME.golden, the transcript it must produce, so a change to the game that
+// alters what a player would see shows up as a diff. Sessions that show
+// wall-clock times (hints, a timed search) do not replay identically and
+// belong in neither.
+
+struct SessionScript {
+    std::string options; // Arguments for parseSessionOptions
+    std::vector<std::string> lines;
+};
+
+bool readSessionScript(const std::string& path, SessionScript& script, std::string& error);
+
+// The frames of script played to its end, or to where its input runs out.
+// Returns false with error set if its options are invalid.
+bool replaySession(const SessionScript& script, std::string& transcript, std::string& error);
+
+// Passes another source's lines through, writing each one taken to a session
+// script as it goes, so a session cut short is still captured up to there.
+class CapturingInput : public InputSource {
+public:
+    // Writes the script header for options to out first.
+    CapturingInput(InputSource& source, FILE* out, const std::string& options);
+
+    bool waitForLine(int timeoutMs) override { return source.waitForLine(timeoutMs); }
+    const std::string& peekLine() const override { return source.peekLine(); }
+    std::string takeLine() override;
+    void discardLine() override { source.discardLine(); } // Replays skip animations anyway
+    uint64_t linesReceived() const override { return source.linesReceived(); }
+    uint64_t nextLineNumber() const override { return source.nextLineNumber(); }
+
+private:
+    InputSource& source;
+    FILE* out;
+};
+
+// Entry point for "EchoGrid --golden PATH [--update]". PATH is a session
+// script or a directory of them; each one's transcript is compared with its
+// .golden file, or written to it with "--update".
+int goldenCommand(int argc, char* argv[]);
@@ -0,0 +1,92 @@
+#include "TranspositionTable.h"
+
+namespace {
+
+const uint64_t VISIT = 1ull << 32;
+
+TableStats unpack(uint64_t packed) {
+    TableStats stats;
+    stats.visits = static_cast<uint32_t>(packed >> 32);
+    stats.score = static_cast<uint32_t>(packed);
+    return stats;
+}
+
+} // namespace
+
+void TableCounters::merge(const TableCounters& other) {
+    probes += other.probes;
+    hits += other.hits;
+    collisions += other.collisions;
+    stores += other.stores;
+    replacements += other.replacements;
+}
+
+TranspositionTable::TranspositionTable(size_t bytes) : bucketCount(0), bucketMask(0) {
+    reset(bytes);
+}
+
+void TranspositionTable::reset(size_t bytes) {
+    size_t wanted = 1;
+    while (wanted * 2 * sizeof(Bucket) <= bytes) wanted *= 2;
+    if (wanted != bucketCount) {
+        bucketCount = wanted;
+        bucketMask = bucketCount - 1;
+        buckets.reset(new Bucket[bucketCount]()); // Zeroed: key 0 is an empty slot
+        return;
+    }
+    for (size_t b = 0; b < bucketCount; ++b) {
+        for (Entry& entry : buckets[b].entries) {
+            entry.key.store(0, std::memory_order_relaxed);
+            entry.stats.store(0, std::memory_order_relaxed);
+        }
+    }
+}
+
+bool TranspositionTable::probe(uint64_t key, TableStats& stats, TableCounters& counters) const {
+    ++counters.probes;
+    const Bucket& bucket = buckets[key & bucketMask];
+    bool full = true;
+    for (const Entry& entry : bucket.entries) {
+        uint64_t stored = entry.key.load(std::memory_order_acquire);
+        if (stored == key) {
+            stats = unpack(entry.stats.load(std::memory_order_relaxed));
+            ++counters.hits;
+            return true;
+        }
+        if (stored == 0) full = false;
+    }
+    if (full) ++counters.collisions;
+    return false;
+}
+
+void TranspositionTable::add(uint64_t key, uint32_t points, TableCounters& counters) {
+    ++counters.stores;
+    Bucket& bucket = buckets[key & bucketMask];
+    Entry* weakest = nullptr;
+    uint32_t weakestVisits = UINT32_MAX;
+    for (Entry& entry : bucket.entries) {
+        uint64_t stored = entry.key.load(std::memory_order_acquire);
+        if (stored == key) {
+            entry.stats.fetch_add(VISIT | points, std::memory_order_relaxed);
+            return;
+        }
+        if (stored == 0) {
+            // Claim the empty slot; if another thread took it, it may have taken it for us
+            if (entry.key.compare_exchange_strong(stored, key, std::memory_order_acq_rel) || stored == key) {
+                entry.stats.fetch_add(VISIT | points, std::memory_order_relaxed);
+                return;
+            }
+        }
+        uint32_t visits = unpack(entry.stats.load(std::memory_order_relaxed)).visits;
+        if (visits < weakestVisits) {
+            weakestVisits = visits;
+            weakest = &entry;
+        }
+    }
+    // Bucket full of other positions: evict the least visited one
+    uint64_t victim = weakest->key.load(std::memory_order_relaxed);
+    if (victim != key && weakest->key.compare_exchange_strong(victim, key, std::memory_order_acq_rel)) {
+        weakest->stats.store(VISIT | points, std::memory_order_relaxed);
+        ++counters.replacements;
+    }
+}
@@ -0,0 +1,150 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include "FixedBoard.h"
+
+// --- Transposition Table ---
+// Search statistics keyed by position rather than by path, shared by every
+// search thread. A position is hashed with Zobrist keys under all eight
+// rotations and reflections of the board and stored under the smallest of
+// the eight, so symmetric positions share one entry.
+//
+// The table is a fixed array of four-entry buckets, one cache line each.
+// Entries are a pair of atomics (key, packed visits and score) updated with
+// CAS and fetch_add, never locks. A lookup only trusts an entry whose key
+// matches in full. A store that finds its bucket full evicts the entry with
+// the fewest visits. Statistics are advisory: a store racing with an
+// eviction of the same entry can be lost.
+
+struct ZobristKeys {
+    uint64_t squares[2][MAX_CELLS]; // [0] Blue Side (X), [1] Red Side (O)
+    uint64_t redToMove;
+};
+
+constexpr uint64_t zobristMix(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+constexpr ZobristKeys makeZobristKeys() {
+    ZobristKeys keys{};
+    uint64_t state = 0x45474B5A4F425249ull; // Fixed, so hashes are stable across runs
+    for (int side = 0; side < 2; ++side) {
+        for (int square = 0; square < MAX_CELLS; ++square) keys.squares[side][square] = zobristMix(state);
+    }
+    keys.redToMove = zobristMix(state);
+    return keys;
+}
+
+inline constexpr ZobristKeys ZOBRIST = makeZobristKeys();
+
+// Where square lands under symmetry s, in the order of makeSymmetryTable.
+inline int symmetryImage(const Board& board, int symmetry, int square) {
+    int n = board.size;
+    int r = square / n;
+    int c = square % n;
+    int m = n - 1;
+    switch (symmetry) {
+    case 0: return r * n + c;
+    case 1: return c * n + (m - r);
+    case 2: return (m - r) * n + (m - c);
+    case 3: return (m - c) * n + r;
+    case 4: return r * n + (m - c);
+    case 5: return (m - r) * n + c;
+    case 6: return c * n + r;
+    default: return (m - c) * n + (m - r);
+    }
+}
+
+template <int N, int K>
+inline int symmetryImage(const FixedBoard<N, K>&, int symmetry, int square) {
+    return BoardTables<N, K>::symmetries.map[symmetry][square];
+}
+
+// The board's Zobrist hash under each symmetry, updated one square at a time.
+struct SymmetricHash {
+    uint64_t images[SYMMETRY_COUNT] = {};
+};
+
+// Toggles square's owner in or out of every image.
+template <typename BoardType>
+inline void toggleSquare(SymmetricHash& hash, const BoardType& board, int square, char owner) {
+    int side = (owner == P1_SYMBOL) ? 0 : 1;
+    for (int s = 0; s < SYMMETRY_COUNT; ++s) {
+        hash.images[s] ^= ZOBRIST.squares[side][symmetryImage(board, s, square)];
+    }
+}
+
+template <typename BoardType>
+inline SymmetricHash hashBoard(const BoardType& board) {
+    SymmetricHash hash;
+    for (int i = 0; i < cellCount(board); ++i) {
+        char owner = cellSymbol(board, i);
+        if (owner != '\0') toggleSquare(hash, board, i, owner);
+    }
+    return hash;
+}
+
+// Key of the position with sideToMove to play, the same for all eight
+// symmetric boards. Never zero, which marks an empty table slot.
+inline uint64_t canonicalKey(const SymmetricHash& hash, char sideToMove) {
+    uint64_t key = hash.images[0];
+    for (int s = 1; s < SYMMETRY_COUNT; ++s) {
+        if (hash.images[s] < key) key = hash.images[s];
+    }
+    if (sideToMove == P2_SYMBOL) key ^= ZOBRIST.redToMove;
+    return key != 0 ? key : 1;
+}
+
+// Kept per search thread and merged at the end, so counting never contends.
+struct TableCounters {
+    uint64_t probes = 0;
+    uint64_t hits = 0;
+    uint64_t collisions = 0;   // Probes whose bucket was full of other positions
+    uint64_t stores = 0;
+    uint64_t replacements = 0; // Stores that evicted another position
+
+    void merge(const TableCounters& other);
+};
+
+struct TableStats {
+    uint32_t visits = 0;
+    uint32_t score = 0; // Half points, as in the search tree
+};
+
+class TranspositionTable {
+public:
+    // Uses the largest power-of-two number of buckets that fits in bytes
+    // (at least one).
+    explicit TranspositionTable(size_t bytes);
+    // Empties the table for another search, resizing it only if bytes makes
+    // for a different number of buckets.
+    void reset(size_t bytes);
+
+    size_t entryCount() const { return bucketCount * BUCKET_SIZE; }
+    size_t byteCount() const { return bucketCount * sizeof(Bucket); }
+
+    bool probe(uint64_t key, TableStats& stats, TableCounters& counters) const;
+    // Adds one visit worth points to the position's entry, creating it if needed.
+    void add(uint64_t key, uint32_t points, TableCounters& counters);
+
+private:
+    static const int BUCKET_SIZE = 4;
+
+    struct Entry {
+        std::atomic<uint64_t> key;
+        std::atomic<uint64_t> stats; // Visits in the high half, score in the low half
+    };
+
+    struct alignas(64) Bucket {
+        Entry entries[BUCKET_SIZE];
+    };
+
+    std::unique_ptr<Bucket[]> buckets;
+    size_t bucketCount;
+    size_t bucketMask;
+};
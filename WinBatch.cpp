@@ -0,0 +1,204 @@
+#include "WinBatch.h"
+#include "Board.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define BATCH_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define TARGET_SSE41
+#define TARGET_AVX2
+#else
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+
+void evaluateScalar(const uint64_t* p1, const uint64_t* p2, size_t begin, size_t count,
+                    const uint64_t* lines, int lineCount, uint64_t full, uint8_t* status) {
+    for (size_t i = begin; i < count; ++i) {
+        uint64_t a = p1[i];
+        uint64_t b = p2[i];
+        bool blueLine = false;
+        bool redLine = false;
+        for (int l = 0; l < lineCount; ++l) {
+            blueLine |= (a & lines[l]) == lines[l];
+            redLine |= (b & lines[l]) == lines[l];
+        }
+        status[i] = static_cast<uint8_t>((blueLine ? BATCH_BLUE_LINE : 0) | (redLine ? BATCH_RED_LINE : 0) |
+                                         ((a | b) == full ? BATCH_FULL : 0));
+    }
+}
+
+#if defined(BATCH_X86)
+// Spreads per-lane movemask bits into status bytes.
+inline void storeStatus(uint8_t* status, int lanes, int blue, int red, int full) {
+    for (int k = 0; k < lanes; ++k) {
+        status[k] = static_cast<uint8_t>(((blue >> k) & 1) | (((red >> k) & 1) << 1) | (((full >> k) & 1) << 2));
+    }
+}
+
+TARGET_SSE41 void evaluateSse41(const uint64_t* p1, const uint64_t* p2, size_t count,
+                                const uint64_t* lines, int lineCount, uint64_t full, uint8_t* status) {
+    const __m128i fullMask = _mm_set1_epi64x(static_cast<long long>(full));
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p1 + i));
+        __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p2 + i));
+        __m128i blue = _mm_setzero_si128();
+        __m128i red = _mm_setzero_si128();
+        for (int l = 0; l < lineCount; ++l) {
+            __m128i line = _mm_set1_epi64x(static_cast<long long>(lines[l]));
+            blue = _mm_or_si128(blue, _mm_cmpeq_epi64(_mm_and_si128(a, line), line));
+            red = _mm_or_si128(red, _mm_cmpeq_epi64(_mm_and_si128(b, line), line));
+        }
+        __m128i filled = _mm_cmpeq_epi64(_mm_or_si128(a, b), fullMask);
+        storeStatus(status + i, 2, _mm_movemask_pd(_mm_castsi128_pd(blue)), _mm_movemask_pd(_mm_castsi128_pd(red)),
+                    _mm_movemask_pd(_mm_castsi128_pd(filled)));
+    }
+    evaluateScalar(p1, p2, i, count, lines, lineCount, full, status);
+}
+
+TARGET_AVX2 void evaluateAvx2(const uint64_t* p1, const uint64_t* p2, size_t count,
+                              const uint64_t* lines, int lineCount, uint64_t full, uint8_t* status) {
+    const __m256i fullMask = _mm256_set1_epi64x(static_cast<long long>(full));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p1 + i));
+        __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p2 + i));
+        __m256i blue = _mm256_setzero_si256();
+        __m256i red = _mm256_setzero_si256();
+        for (int l = 0; l < lineCount; ++l) {
+            __m256i line = _mm256_set1_epi64x(static_cast<long long>(lines[l]));
+            blue = _mm256_or_si256(blue, _mm256_cmpeq_epi64(_mm256_and_si256(a, line), line));
+            red = _mm256_or_si256(red, _mm256_cmpeq_epi64(_mm256_and_si256(b, line), line));
+        }
+        __m256i filled = _mm256_cmpeq_epi64(_mm256_or_si256(a, b), fullMask);
+        storeStatus(status + i, 4, _mm256_movemask_pd(_mm256_castsi256_pd(blue)), _mm256_movemask_pd(_mm256_castsi256_pd(red)),
+                    _mm256_movemask_pd(_mm256_castsi256_pd(filled)));
+    }
+    evaluateScalar(p1, p2, i, count, lines, lineCount, full, status);
+}
+
+// What the CPU (and, for AVX, the OS) supports.
+void detectFeatures(bool& sse41, bool& avx2) {
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    sse41 = (info[2] & (1 << 19)) != 0;
+    bool osSavesAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+    avx2 = false;
+    if (osSavesAvx && maxLeaf >= 7) {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    sse41 = __builtin_cpu_supports("sse4.1");
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+} // namespace
+
+bool batchKernelSupported(BatchKernel kernel) {
+    if (kernel == BatchKernel::Scalar) return true;
+#if defined(BATCH_X86)
+    static bool sse41 = false;
+    static bool avx2 = false;
+    static bool detected = (detectFeatures(sse41, avx2), true);
+    (void)detected;
+    return kernel == BatchKernel::Avx2 ? avx2 : sse41;
+#else
+    return false;
+#endif
+}
+
+BatchKernel bestBatchKernel() {
+    if (batchKernelSupported(BatchKernel::Avx2)) return BatchKernel::Avx2;
+    if (batchKernelSupported(BatchKernel::Sse41)) return BatchKernel::Sse41;
+    return BatchKernel::Scalar;
+}
+
+const char* batchKernelName(BatchKernel kernel) {
+    switch (kernel) {
+    case BatchKernel::Avx2: return "AVX2";
+    case BatchKernel::Sse41: return "SSE4.1";
+    default: return "scalar";
+    }
+}
+
+// --- Game Batch ---
+GameBatch::GameBatch(int size, int winLength) : cells(size * size) {
+    fullMask = (cells == 64) ? ~0ull : (1ull << cells) - 1;
+    // Every run of winLength squares in the four directions
+    const int steps[4][2] = { {0, 1}, {1, 0}, {1, 1}, {1, -1} };
+    for (const auto& step : steps) {
+        for (int r = 0; r < size; ++r) {
+            for (int c = 0; c < size; ++c) {
+                int endR = r + step[0] * (winLength - 1);
+                int endC = c + step[1] * (winLength - 1);
+                if (endR < 0 || endR >= size || endC < 0 || endC >= size) continue;
+                uint64_t line = 0;
+                for (int k = 0; k < winLength; ++k) line |= 1ull << ((r + step[0] * k) * size + (c + step[1] * k));
+                lines.push_back(line);
+            }
+        }
+    }
+}
+
+void GameBatch::add(uint32_t id, uint64_t blue, uint64_t red) {
+    ids.push_back(id);
+    p1.push_back(blue);
+    p2.push_back(red);
+}
+
+void GameBatch::place(size_t slot, char playerSymbol, int square) {
+    uint64_t bit = 1ull << square;
+    if (playerSymbol == P1_SYMBOL) {
+        p1[slot] |= bit;
+        p2[slot] &= ~bit;
+    }
+    else {
+        p2[slot] |= bit;
+        p1[slot] &= ~bit;
+    }
+}
+
+void GameBatch::evaluate(std::vector<uint8_t>& status, BatchKernel kernel) const {
+    status.resize(ids.size());
+    int lineCount = static_cast<int>(lines.size());
+#if defined(BATCH_X86)
+    if (kernel == BatchKernel::Avx2 && batchKernelSupported(kernel)) {
+        evaluateAvx2(p1.data(), p2.data(), ids.size(), lines.data(), lineCount, fullMask, status.data());
+        return;
+    }
+    if (kernel != BatchKernel::Scalar && batchKernelSupported(BatchKernel::Sse41)) {
+        evaluateSse41(p1.data(), p2.data(), ids.size(), lines.data(), lineCount, fullMask, status.data());
+        return;
+    }
+#else
+    (void)kernel;
+#endif
+    evaluateScalar(p1.data(), p2.data(), 0, ids.size(), lines.data(), lineCount, fullMask, status.data());
+}
+
+void GameBatch::compact(const std::vector<uint8_t>& status, std::vector<std::pair<uint32_t, uint8_t>>& finished) {
+    // Walk backwards so a game moved into a gap has already been checked.
+    for (size_t slot = ids.size(); slot-- > 0;) {
+        if (status[slot] == 0) continue;
+        finished.push_back({ids[slot], status[slot]});
+        size_t last = ids.size() - 1;
+        ids[slot] = ids[last];
+        p1[slot] = p1[last];
+        p2[slot] = p2[last];
+        ids.pop_back();
+        p1.pop_back();
+        p2.pop_back();
+    }
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// --- Batched Win/Draw Evaluation ---
+// Many in-flight games of one geometry stored as structure of arrays: every
+// game's Blue Side marks in one array and Red Side's in another, one 64-bit
+// mask per game (boards up to 8x8). evaluate() tests every game against
+// every line of the geometry, four games per instruction with AVX2, two
+// with SSE4.1, or one at a time in portable code; the widest kernel the CPU
+// supports is picked at run time. Finished games are compacted out so the
+// arrays stay dense.
+
+const int MAX_BATCH_CELLS = 64;
+
+// Status bits per game; a game is finished when any is set.
+const uint8_t BATCH_BLUE_LINE = 1; // Blue Side has a complete line
+const uint8_t BATCH_RED_LINE = 2;  // Red Side has a complete line
+const uint8_t BATCH_FULL = 4;      // No empty squares left
+
+enum class BatchKernel { Scalar, Sse41, Avx2 };
+
+BatchKernel bestBatchKernel();
+bool batchKernelSupported(BatchKernel kernel);
+const char* batchKernelName(BatchKernel kernel);
+
+class GameBatch {
+public:
+    // size * size must be at most MAX_BATCH_CELLS.
+    GameBatch(int size, int winLength);
+
+    int cellCount() const { return cells; }
+    size_t count() const { return ids.size(); }
+    bool empty() const { return ids.empty(); }
+
+    void add(uint32_t id, uint64_t blue = 0, uint64_t red = 0);
+    void place(size_t slot, char playerSymbol, int square);
+    uint32_t id(size_t slot) const { return ids[slot]; }
+    uint64_t blue(size_t slot) const { return p1[slot]; }
+    uint64_t red(size_t slot) const { return p2[slot]; }
+
+    // Fills status with one byte of BATCH_ bits per game, in slot order.
+    void evaluate(std::vector<uint8_t>& status, BatchKernel kernel = bestBatchKernel()) const;
+
+    // Removes every game whose status is non-zero, appending (id, status)
+    // to finished. The last games move into the gaps, so slots change.
+    void compact(const std::vector<uint8_t>& status, std::vector<std::pair<uint32_t, uint8_t>>& finished);
+
+private:
+    int cells;
+    uint64_t fullMask;
+    std::vector<uint64_t> lines;
+    std::vector<uint64_t> p1; // Blue Side (X)
+    std::vector<uint64_t> p2; // Red Side (O)
+    std::vector<uint32_t> ids;
+};